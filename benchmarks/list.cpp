@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include "option.h"
+
+using namespace inicpp;
+
+namespace
+{
+	/** Option with list of given number of integers written as strings, like after parsing */
+	option string_list(size_t count)
+	{
+		std::vector<std::string> values;
+		for (size_t i = 0; i < count; ++i) { values.push_back(std::to_string(i)); }
+		return option("list", std::move(values));
+	}
+} // namespace
+
+static void list_get_list(benchmark::State &state)
+{
+	option opt = string_list(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		signed_ini_t sum = 0;
+		for (auto value : opt.get_list<signed_ini_t>()) { sum += value; }
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(list_get_list)->Arg(100)->Arg(10000);
+
+static void list_values(benchmark::State &state)
+{
+	option opt = string_list(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		signed_ini_t sum = 0;
+		for (auto value : opt.values<signed_ini_t>()) { sum += value; }
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(list_values)->Arg(100)->Arg(10000);
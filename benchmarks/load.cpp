@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <memory_resource>
+
+#include "parser.h"
+
+using namespace inicpp;
+
+namespace
+{
+	/** Ini text with given number of sections, each with twenty options of different kinds */
+	std::string generated_config(size_t sections)
+	{
+		std::string text;
+		for (size_t i = 0; i < sections; ++i) {
+			text += "[section" + std::to_string(i) + "]\n";
+			for (size_t j = 0; j < 20; ++j) {
+				text += "option" + std::to_string(j) + " = ";
+				switch (j % 4) {
+				case 0: text += std::to_string(i * j); break;
+				case 1: text += "some longer text value which does not fit into small string buffer"; break;
+				case 2: text += "1, 2, 3, 4, 5, 6, 7, 8"; break;
+				default: text += "yes"; break;
+				}
+				text += " ; comment\n";
+			}
+		}
+		return text;
+	}
+
+	/** Ini text with single option containing list of given number of values */
+	std::string list_config(size_t count)
+	{
+		std::string text = "[section]\nlist = ";
+		for (size_t i = 0; i < count; ++i) {
+			if (i != 0) { text += ", "; }
+			text += "v" + std::to_string(i % 1000);
+		}
+		return text + "\n";
+	}
+
+	/** Ini text with single option containing value with given number of escaped pairs of characters */
+	std::string escaped_config(size_t count)
+	{
+		std::string text = "[section]\nescaped = \\ ";
+		for (size_t i = 0; i < count; ++i) { text += "\\,\\\\"; }
+		return text + "\\ \n";
+	}
+} // namespace
+
+static void load_string(benchmark::State &state)
+{
+	std::string text = generated_config(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) { benchmark::DoNotOptimize(parser::load(text)); }
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(load_string)->Arg(10)->Arg(1000);
+
+static void load_string_arena(benchmark::State &state)
+{
+	std::string text = generated_config(static_cast<size_t>(state.range(0)));
+	std::pmr::monotonic_buffer_resource arena;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(parser::load(text, &arena));
+		arena.release();
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(load_string_arena)->Arg(10)->Arg(1000);
+
+static void load_string_interned(benchmark::State &state)
+{
+	std::string text = generated_config(static_cast<size_t>(state.range(0)));
+	symbol_table symbols;
+	for (auto _ : state) { benchmark::DoNotOptimize(parser::load(text, symbols)); }
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+	state.counters["symbols"] = static_cast<double>(symbols.size());
+}
+BENCHMARK(load_string_interned)->Arg(10)->Arg(1000);
+
+static void load_long_list(benchmark::State &state)
+{
+	std::string text = list_config(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		config cfg = parser::load(text);
+		benchmark::DoNotOptimize(cfg["section"]["list"].size());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(load_long_list)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+
+static void load_long_escaped_value(benchmark::State &state)
+{
+	std::string text = escaped_config(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) {
+		config cfg = parser::load(text);
+		benchmark::DoNotOptimize(cfg["section"]["escaped"].size());
+	}
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(load_long_escaped_value)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
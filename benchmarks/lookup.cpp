@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include "bound_option.h"
+#include "config.h"
+#include "frozen_config.h"
+#include "schema.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace inicpp;
+
+namespace
+{
+	/** Names of looked up elements in random order, so the lookups do not follow the insertion order */
+	std::vector<std::string> shuffled_names(const std::string &prefix, size_t count)
+	{
+		std::vector<std::string> names;
+		names.reserve(count);
+		for (size_t i = 0; i < count; ++i) { names.push_back(prefix + std::to_string(i)); }
+		std::shuffle(names.begin(), names.end(), std::mt19937(42));
+		return names;
+	}
+
+	/** Run lookup of all names in given container and report number of processed lookups */
+	template <typename Container>
+	void run_lookups(benchmark::State &state, const Container &container, const std::vector<std::string> &names)
+	{
+		for (auto _ : state) {
+			for (auto &name : names) { benchmark::DoNotOptimize(&container[name]); }
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+	}
+} // namespace
+
+static void config_lookup(benchmark::State &state)
+{
+	size_t count = static_cast<size_t>(state.range(0));
+	config cfg;
+	for (size_t i = 0; i < count; ++i) { cfg.add_section("section" + std::to_string(i)); }
+
+	run_lookups(state, cfg, shuffled_names("section", count));
+}
+BENCHMARK(config_lookup)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void frozen_config_lookup(benchmark::State &state)
+{
+	size_t count = static_cast<size_t>(state.range(0));
+	config cfg;
+	for (size_t i = 0; i < count; ++i) { cfg.add_section("section" + std::to_string(i)); }
+	frozen_config frozen = cfg.freeze();
+	std::vector<std::string> names = shuffled_names("section", count);
+
+	// views are returned by value, so they cannot be passed to run_lookups
+	for (auto _ : state) {
+		for (auto &name : names) { benchmark::DoNotOptimize(frozen[name]); }
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+}
+BENCHMARK(frozen_config_lookup)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void section_lookup(benchmark::State &state)
+{
+	size_t count = static_cast<size_t>(state.range(0));
+	section sect("section");
+	for (size_t i = 0; i < count; ++i) { sect.add_option("option" + std::to_string(i), signed_ini_t(0)); }
+
+	run_lookups(state, sect, shuffled_names("option", count));
+}
+BENCHMARK(section_lookup)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void schema_lookup(benchmark::State &state)
+{
+	size_t count = static_cast<size_t>(state.range(0));
+	schema schm;
+	for (size_t i = 0; i < count; ++i) {
+		section_schema_params params;
+		params.name = "section" + std::to_string(i);
+		schm.add_section(params);
+	}
+
+	run_lookups(state, schm, shuffled_names("section", count));
+}
+BENCHMARK(schema_lookup)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void section_schema_lookup(benchmark::State &state)
+{
+	size_t count = static_cast<size_t>(state.range(0));
+	section_schema_params sect_params;
+	sect_params.name = "section";
+	section_schema sect_schema(sect_params);
+	for (size_t i = 0; i < count; ++i) {
+		option_schema_params<signed_ini_t> params;
+		params.name = "option" + std::to_string(i);
+		sect_schema.add_option(params);
+	}
+
+	run_lookups(state, sect_schema, shuffled_names("option", count));
+}
+BENCHMARK(section_schema_lookup)->Arg(10)->Arg(1000)->Arg(100000);
+
+/** Config with given number of sections, each containing the same number of options */
+static config square_config(size_t count)
+{
+	config cfg;
+	for (size_t i = 0; i < count; ++i) {
+		std::string sect_name = "section" + std::to_string(i);
+		cfg.add_section(sect_name);
+		for (size_t j = 0; j < count; ++j) { cfg.add_option(sect_name, "option" + std::to_string(j), signed_ini_t(0)); }
+	}
+	return cfg;
+}
+
+static void option_by_names(benchmark::State &state)
+{
+	config cfg = square_config(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) { benchmark::DoNotOptimize(&cfg["section7"]["option7"]); }
+}
+BENCHMARK(option_by_names)->Arg(10)->Arg(300);
+
+static void option_by_handle(benchmark::State &state)
+{
+	config cfg = square_config(static_cast<size_t>(state.range(0)));
+	config::key_handle handle = cfg.handle("section7", "option7");
+	for (auto _ : state) { benchmark::DoNotOptimize(&cfg[handle]); }
+}
+BENCHMARK(option_by_handle)->Arg(10)->Arg(300);
+
+static void option_get_by_names(benchmark::State &state)
+{
+	config cfg = square_config(static_cast<size_t>(state.range(0)));
+	for (auto _ : state) { benchmark::DoNotOptimize(cfg["section7"]["option7"].get<signed_ini_t>()); }
+}
+BENCHMARK(option_get_by_names)->Arg(10)->Arg(300);
+
+static void frozen_option_get_by_names(benchmark::State &state)
+{
+	frozen_config frozen = square_config(static_cast<size_t>(state.range(0))).freeze();
+	for (auto _ : state) { benchmark::DoNotOptimize(frozen["section7"]["option7"].get<signed_ini_t>()); }
+}
+BENCHMARK(frozen_option_get_by_names)->Arg(10)->Arg(300);
+
+static void option_get_bound(benchmark::State &state)
+{
+	config cfg = square_config(static_cast<size_t>(state.range(0)));
+	bound_option<signed_ini_t> bound(cfg, "section7", "option7");
+	for (auto _ : state) { benchmark::DoNotOptimize(bound.get()); }
+}
+BENCHMARK(option_get_bound)->Arg(10)->Arg(300);
@@ -0,0 +1,133 @@
+#ifndef INICPP_BOUND_OPTION_H
+#define INICPP_BOUND_OPTION_H
+
+#include <limits>
+#include <string>
+
+#include "config.h"
+#include "exception.h"
+#include "option.h"
+
+namespace inicpp
+{
+	/**
+	 * Live typed binding of one option of given config.
+	 * Converted value is cached and refreshed only when the option was modified,
+	 * or when config layout changed (sections or options were removed or replaced,
+	 * or whole config was assigned). Up to date value is read without any lookup
+	 * or conversion. Bound config has to outlive the binding; like config itself,
+	 * binding must not be read concurrently with modifications of the config.
+	 */
+	template <typename ValueType> class bound_option
+	{
+	private:
+		/** Version which no option can have, marks that no value is cached */
+		static constexpr uint64_t no_version = std::numeric_limits<uint64_t>::max();
+
+		/** Config which contains the option */
+		const config *config_;
+		/** Pre-resolved reference to the option */
+		mutable config::key_handle handle_;
+		/** Modification count of the option when value was cached */
+		mutable uint64_t version_;
+		/** Cached converted value */
+		mutable ValueType value_;
+		/** Value used if option is missing or cannot be converted */
+		ValueType default_value_;
+		/** True if default value was given */
+		bool has_default_;
+
+		/**
+		 * Determines whether cached value belongs to current state of the option.
+		 */
+		bool is_fresh() const
+		{
+			return config_->is_current(handle_) && handle_.option_->version_ == version_;
+		}
+
+		/**
+		 * Look up and convert the value again.
+		 * @throws not_found_exception if option is missing and there is no default value
+		 * @throws bad_cast_exception if value cannot be converted and there is no default value
+		 */
+		void refresh() const
+		{
+			version_ = no_version;
+			const option *opt = config_->find(handle_);
+			if (has_default_) {
+				value_ = (opt == nullptr ? default_value_ : opt->get_or<ValueType>(default_value_));
+			} else {
+				value_ = (*config_)[handle_].template get<ValueType>();
+			}
+			// missing option has no version, handle of it is never current so it is looked up again
+			if (opt != nullptr) { version_ = opt->version_; }
+		}
+
+	public:
+		/**
+		 * Bind option in specified section of given config.
+		 * Option is looked up on the first read, it does not have to exist now.
+		 * @param cfg config which contains the option, has to outlive the binding
+		 * @param section_name name of section which contains the option
+		 * @param option_name name of bound option
+		 */
+		bound_option(const config &cfg, std::string section_name, std::string option_name)
+			: config_(&cfg), handle_(std::move(section_name), std::move(option_name)), version_(no_version), value_(),
+			  default_value_(), has_default_(false)
+		{
+		}
+		/**
+		 * Bind option in specified section of given config,
+		 * default value is read if the option is missing or cannot be converted.
+		 * @param cfg config which contains the option, has to outlive the binding
+		 * @param section_name name of section which contains the option
+		 * @param option_name name of bound option
+		 * @param default_value value used if option is not available
+		 */
+		bound_option(const config &cfg, std::string section_name, std::string option_name, ValueType default_value)
+			: config_(&cfg), handle_(std::move(section_name), std::move(option_name)), version_(no_version), value_(),
+			  default_value_(std::move(default_value)), has_default_(true)
+		{
+		}
+
+		/**
+		 * Get current value of the option, converted only if the option was modified since last read.
+		 * If option is list, than return first element of it.
+		 * @return constant reference to cached value, valid until next read
+		 * @throws not_found_exception if option is missing and there is no default value
+		 * @throws bad_cast_exception if value cannot be converted and there is no default value
+		 */
+		const ValueType &get() const
+		{
+			if (!is_fresh()) { refresh(); }
+			return value_;
+		}
+		/**
+		 * Alias for get() function.
+		 * @return constant reference to cached value, valid until next read
+		 */
+		const ValueType &operator*() const
+		{
+			return get();
+		}
+
+		/**
+		 * Getter for name of section which contains the option.
+		 * @return section name
+		 */
+		const std::string &section_name() const
+		{
+			return handle_.section_name();
+		}
+		/**
+		 * Getter for name of bound option.
+		 * @return option name
+		 */
+		const std::string &option_name() const
+		{
+			return handle_.option_name();
+		}
+	};
+} // namespace inicpp
+
+#endif // INICPP_BOUND_OPTION_H
@@ -2,11 +2,12 @@
 #define INICPP_CONFIG_H
 
 #include <iostream>
-#include <map>
+#include <memory_resource>
 #include <vector>
 
 #include "dll.h"
 #include "exception.h"
+#include "name_index.h"
 #include "option.h"
 #include "schema.h"
 #include "section.h"
@@ -16,26 +17,37 @@ namespace inicpp
 {
 	/** Forward declaration, stated because of ring dependencies */
 	class schema;
+	/** Forward declaration of typed binding, which reads options through key handles */
+	template <typename ValueType> class bound_option;
+	/** Forward declaration of immutable snapshot of config */
+	class frozen_config;
 	/** Forward declaration of iterator used in config class */
 	template <typename Element> class config_iterator;
 
 
 	/**
 	 * Represents the base object of ini configuration.
-	 * Contains list of sections in logical map structure.
+	 * Contains ordered list of sections, which are indexed by their names.
 	 * Can be constructed directly from string or stream.
+	 * Sections, options and the lists of them are allocated from memory resource of the config,
+	 * so whole config can be placed into an arena. Names and values use global heap.
 	 */
 	class INICPP_API config
 	{
 	private:
-		using sections_vector = std::vector<std::shared_ptr<section>>;
-		using sections_map = std::map<std::string, std::shared_ptr<section>>;
-		using sections_map_pair = std::pair<std::string, std::shared_ptr<section>>;
+		using sections_vector = std::pmr::vector<std::shared_ptr<section>>;
+		using sections_index = name_index<section>;
 
 		/** List of sections in this config instance */
 		sections_vector sections_;
-		/** Map of sections for better searching */
-		sections_map sections_map_;
+		/** Positions of sections in the list for better searching */
+		sections_index sections_index_;
+
+		/** Allocator which places sections into memory resource of this config */
+		std::pmr::polymorphic_allocator<section> section_allocator() const
+		{
+			return sections_.get_allocator();
+		}
 
 		friend class config_iterator<section>;
 		friend class config_iterator<const section>;
@@ -47,44 +59,167 @@ namespace inicpp
 		using const_iterator = config_iterator<const section>;
 
 		/**
-		 * Default constructor.
+		 * Pre-resolved reference to option in section, which makes repeated access
+		 * as cheap as comparison of two numbers. Handle remembers where the option was found
+		 * together with layout generations of config and section. If they do not match on access
+		 * (sections or options were removed or replaced, or handle is used with other config),
+		 * option is looked up again by names, so handle never dangles.
+		 */
+		class INICPP_API key_handle
+		{
+		private:
+			/** Name of section which contains the option */
+			std::string section_name_;
+			/** Name of referenced option */
+			std::string option_name_;
+			/** Generation of config sections when option was found, 0 if it was not found */
+			uint64_t config_generation_;
+			/** Generation of section options when option was found */
+			uint64_t section_generation_;
+			/** Section which contained the option */
+			section *section_;
+			/** Found option */
+			option *option_;
+
+			friend class config;
+			template <typename ValueType> friend class bound_option;
+
+		public:
+			/**
+			 * Construct unresolved handle, option is looked up on first access.
+			 * @param section_name name of section which contains the option
+			 * @param option_name name of referenced option
+			 */
+			key_handle(std::string section_name, std::string option_name);
+
+			/**
+			 * Getter for name of section which contains the option.
+			 * @return section name
+			 */
+			const std::string &section_name() const;
+			/**
+			 * Getter for name of referenced option.
+			 * @return option name
+			 */
+			const std::string &option_name() const;
+		};
+
+	private:
+		/**
+		 * Look up option of the handle by names and remember current layout in it.
+		 * @param handle handle which will be resolved
+		 * @return found option, nullptr if section or option is not present
+		 */
+		option *resolve(key_handle &handle) const;
+		/**
+		 * Name of element which made resolving of the handle fail.
+		 * @param handle unresolved handle
+		 * @return section name if section is missing, option name otherwise
+		 */
+		const std::string &missing_name(const key_handle &handle) const;
+
+	public:
+		/**
+		 * Default constructor, config allocates from default memory resource.
 		 */
 		config();
 		/**
-		 * Copy constructor.
+		 * Construct empty config, which allocates its sections and options from given memory resource.
+		 * Monotonic resource lets whole config be allocated in one arena and released at once.
+		 * @param resource memory resource which has to outlive the config
+		 */
+		explicit config(std::pmr::memory_resource *resource);
+		/**
+		 * Copy constructor, copy allocates from default memory resource.
 		 */
 		config(const config &source);
 		/**
-		 * Copy assignment.
+		 * Copy constructor which allocates the copy from given memory resource.
+		 * @param source copied config
+		 * @param resource memory resource which has to outlive the config
+		 */
+		config(const config &source, std::pmr::memory_resource *resource);
+		/**
+		 * Copy assignment, config keeps its memory resource.
 		 */
 		config &operator=(const config &source);
 		/**
-		 * Move constructor.
+		 * Move constructor, config keeps memory resource of the source.
 		 */
 		config(config &&source);
 		/**
-		 * Move assignment.
+		 * Move constructor which places sections into given memory resource.
+		 * Sections and options are moved one by one if resource differs from the one of the source.
+		 * @param source moved config
+		 * @param resource memory resource which has to outlive the config
+		 */
+		config(config &&source, std::pmr::memory_resource *resource);
+		/**
+		 * Move assignment, config keeps its memory resource.
 		 */
 		config &operator=(config &&source);
 
+		/**
+		 * Getter for memory resource, which sections and options of this config are allocated from.
+		 * @return pointer to memory resource
+		 */
+		std::pmr::memory_resource *get_memory_resource() const;
+
+		/**
+		 * Pack this config into immutable frozen config, which is stored in one buffer
+		 * and looks up sections and options by perfect hash.
+		 * @return newly created frozen config, which does not reference this config
+		 */
+		frozen_config freeze() const;
+
+		/**
+		 * Share names and single long string values of all sections and options
+		 * with other configs through given symbol table.
+		 * @param symbols table which has to outlive this config and all its copies
+		 */
+		void intern(symbol_table &symbols);
+
 		/**
 		 * Add section to this ini configuration.
 		 * @param sect section which will be added
 		 * @throws ambiguity_exception if section with specified name exists
 		 */
 		void add_section(const section &sect);
+		/**
+		 * Add section to this ini configuration, section is moved into the config.
+		 * @param sect section which will be added
+		 * @throws ambiguity_exception if section with specified name exists
+		 */
+		void add_section(section &&sect);
 		/**
 		 * Create and add section with specified name.
 		 * @param section_name section with same name cannot exist in config
 		 * @throws ambiguity_exception if section with specified name exists
 		 */
 		void add_section(const std::string &section_name);
+		/**
+		 * Construct section in place from given arguments and add it to this config.
+		 * @param args arguments of section constructor, the first one is section name
+		 * @return modifiable reference to newly created section
+		 * @throws ambiguity_exception if section with the same name exists
+		 */
+		template <typename... Args> section &emplace_section(Args &&...args)
+		{
+			std::shared_ptr<section> sect =
+				std::allocate_shared<section>(section_allocator(), std::forward<Args>(args)..., get_memory_resource());
+			if (sections_index_.find(sect->get_name(), sections_) != sections_index::npos) {
+				throw ambiguity_exception(sect->get_name());
+			}
+			sections_.push_back(std::move(sect));
+			sections_index_.push_back(sections_);
+			return *sections_.back();
+		}
 		/**
 		 * Remove section from internal sections list.
 		 * @param section_name name should exist in section list
 		 * @throws not_found_exception if section with given name does not exist
 		 */
-		void remove_section(const std::string &section_name);
+		void remove_section(std::string_view section_name);
 
 		/**
 		 * Add given option to specified section.
@@ -93,7 +228,30 @@ namespace inicpp
 		 * @throws not_found_exception if section with given name does not exist
 		 * @throws ambiguity_exception if option with specified name exists
 		 */
-		void add_option(const std::string &section_name, const option &opt);
+		void add_option(std::string_view section_name, const option &opt);
+		/**
+		 * Add given option to specified section, option is moved into the section.
+		 * @param section_name should exist
+		 * @param opt option which will be added to appropriate section
+		 * @throws not_found_exception if section with given name does not exist
+		 * @throws ambiguity_exception if option with specified name exists
+		 */
+		void add_option(std::string_view section_name, option &&opt);
+		/**
+		 * Construct option in place in specified section.
+		 * @param section_name should exist
+		 * @param args arguments of option constructor, the first one is option name
+		 * @return modifiable reference to newly created option
+		 * @throws not_found_exception if section with given name does not exist
+		 * @throws ambiguity_exception if option with the same name exists
+		 */
+		template <typename... Args> option &emplace_option(std::string_view section_name, Args &&...args)
+		{
+			size_t sect_pos = sections_index_.find(section_name, sections_);
+			if (sect_pos == sections_index::npos) { throw not_found_exception(std::string(section_name)); }
+
+			return sections_[sect_pos]->emplace_option(std::forward<Args>(args)...);
+		}
 		/**
 		 * Creates and add option to specified section.
 		 * @param section_name should exist in this config
@@ -102,15 +260,13 @@ namespace inicpp
 		 * @throws ambiguity_exception if option with specified name exists
 		 */
 		template <typename ValueType>
-		void add_option(const std::string &section_name, const std::string &option_name, ValueType value)
+		void add_option(std::string_view section_name, const std::string &option_name, ValueType value)
 		{
-			auto sect_it = sections_map_.find(section_name);
-			if (sect_it != sections_map_.end()) {
-				option opt(option_name);
-				opt.set<ValueType>(value);
-				sect_it->second->add_option(opt);
+			size_t sect_pos = sections_index_.find(section_name, sections_);
+			if (sect_pos != sections_index::npos) {
+				sections_[sect_pos]->add_option(option_name, std::move(value));
 			} else {
-				throw not_found_exception(section_name);
+				throw not_found_exception(std::string(section_name));
 			}
 		}
 
@@ -122,7 +278,7 @@ namespace inicpp
 		 * with given name does not exist
 		 * @throws not_found_exception if section or option with given name does not exist
 		 */
-		void remove_option(const std::string &section_name, const std::string &option_name);
+		void remove_option(std::string_view section_name, std::string_view option_name);
 
 		/**
 		 * Returns size of sections list
@@ -149,20 +305,113 @@ namespace inicpp
 		 * @return modifiable reference to stored section
 		 * @throws not_found_exception if section with given name does not exist
 		 */
-		section &operator[](const std::string &section_name);
+		section &operator[](std::string_view section_name);
 		/**
 		 * Access constant reference on section with specified name.
 		 * @param section_name name of requested section
 		 * @return constant reference to stored section
 		 * @throws not_found_exception if section with given name does not exist
 		 */
-		const section &operator[](const std::string &section_name) const;
+		const section &operator[](std::string_view section_name) const;
 		/**
 		 * Tries to find section with specified name inside this config.
 		 * @param section_name name which is searched
 		 * @return true if section with this name is present, false otherwise
 		 */
-		bool contains(const std::string &section_name) const;
+		bool contains(std::string_view section_name) const;
+		/**
+		 * Find section with specified name without throwing if it does not exist.
+		 * @param section_name name which is searched
+		 * @return pointer to stored section, nullptr if section is not present
+		 */
+		section *find(std::string_view section_name);
+		/**
+		 * Find section with specified name without throwing if it does not exist.
+		 * @param section_name name which is searched
+		 * @return pointer to stored section, nullptr if section is not present
+		 */
+		const section *find(std::string_view section_name) const;
+		/**
+		 * Get single value of option in specified section.
+		 * Does not throw if section or option is missing or value cannot be converted.
+		 * @param section_name name of section which contains the option
+		 * @param option_name name of requested option
+		 * @return converted value, or empty optional if it is not available
+		 */
+		template <typename ReturnType>
+		std::optional<ReturnType> try_get(std::string_view section_name, std::string_view option_name) const
+		{
+			const section *sect = find(section_name);
+			if (sect == nullptr) { return std::nullopt; }
+			return sect->try_get<ReturnType>(option_name);
+		}
+		/**
+		 * Get single value of option in specified section, or given default.
+		 * Does not throw if section or option is missing or value cannot be converted.
+		 * @param section_name name of section which contains the option
+		 * @param option_name name of requested option
+		 * @param default_value returned if value is not available
+		 * @return converted value or @a default_value
+		 */
+		template <typename ReturnType>
+		ReturnType get_or(std::string_view section_name, std::string_view option_name, ReturnType default_value) const
+		{
+			const section *sect = find(section_name);
+			if (sect == nullptr) { return default_value; }
+			return sect->get_or<ReturnType>(option_name, std::move(default_value));
+		}
+
+		/**
+		 * Create handle of option in specified section and resolve it against this config.
+		 * Option does not have to exist yet, handle is resolved again on access.
+		 * @param section_name name of section which contains the option
+		 * @param option_name name of referenced option
+		 * @return resolved handle
+		 */
+		key_handle handle(std::string_view section_name, std::string_view option_name) const;
+		/**
+		 * Determines whether handle is resolved against current layout of this config,
+		 * so the access through it does not need any lookup.
+		 * @param handle checked handle
+		 * @return true if handle is up to date, false if it is stale or option was not found
+		 */
+		bool is_current(const key_handle &handle) const
+		{
+			return handle.config_generation_ == sections_index_.generation() &&
+				handle.section_generation_ == handle.section_->options_index_.generation();
+		}
+		/**
+		 * Access option referenced by handle, stale handle is resolved again.
+		 * @param handle handle created by handle() of any config
+		 * @return pointer to stored option, nullptr if section or option is not present
+		 */
+		option *find(key_handle &handle)
+		{
+			return is_current(handle) ? handle.option_ : resolve(handle);
+		}
+		/**
+		 * Access option referenced by handle, stale handle is resolved again.
+		 * @param handle handle created by handle() of any config
+		 * @return pointer to stored option, nullptr if section or option is not present
+		 */
+		const option *find(key_handle &handle) const
+		{
+			return is_current(handle) ? handle.option_ : resolve(handle);
+		}
+		/**
+		 * Access option referenced by handle, stale handle is resolved again.
+		 * @param handle handle created by handle() of any config
+		 * @return modifiable reference to stored option
+		 * @throws not_found_exception if section or option does not exist
+		 */
+		option &operator[](key_handle &handle);
+		/**
+		 * Access option referenced by handle, stale handle is resolved again.
+		 * @param handle handle created by handle() of any config
+		 * @return constant reference to stored option
+		 * @throws not_found_exception if section or option does not exist
+		 */
+		const option &operator[](key_handle &handle) const;
 
 		/**
 		 * Validates this config agains given schema.
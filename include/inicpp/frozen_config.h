@@ -0,0 +1,625 @@
+#ifndef INICPP_FROZEN_CONFIG_H
+#define INICPP_FROZEN_CONFIG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "config.h"
+#include "dll.h"
+#include "exception.h"
+#include "string_utils.h"
+#include "types.h"
+
+namespace inicpp
+{
+	/** Forward declaration of read-only option of frozen config */
+	class frozen_option;
+	/** Forward declaration of read-only section of frozen config */
+	class frozen_section;
+
+
+	/**
+	 * Iterator over elements of frozen config or frozen section.
+	 * Elements are lightweight views, which are returned by value.
+	 */
+	template <typename Container, typename View> class frozen_iterator
+	{
+	private:
+		/** Iterated container */
+		const Container *container_;
+		/** Position in iterated container */
+		size_t position_;
+
+	public:
+		// iterator traits
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = View;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = View;
+
+		/**
+		 * Construct iterator pointing at given position of container.
+		 * @param container iterated container
+		 * @param position position of the element
+		 */
+		frozen_iterator(const Container &container, size_t position) : container_(&container), position_(position)
+		{
+		}
+
+		/**
+		 * Get element on current position.
+		 * @return view of the element
+		 */
+		View operator*() const
+		{
+			return (*container_)[position_];
+		}
+		/**
+		 * Move to the next element.
+		 * @return reference to this
+		 */
+		frozen_iterator &operator++()
+		{
+			++position_;
+			return *this;
+		}
+		/**
+		 * Move to the next element.
+		 * @return iterator pointing at the previous element
+		 */
+		frozen_iterator operator++(int)
+		{
+			frozen_iterator result(*this);
+			++position_;
+			return result;
+		}
+		/**
+		 * Equality operator.
+		 */
+		bool operator==(const frozen_iterator &other) const
+		{
+			return container_ == other.container_ && position_ == other.position_;
+		}
+		/**
+		 * Inequality operator.
+		 */
+		bool operator!=(const frozen_iterator &other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+
+	/**
+	 * Immutable snapshot of config packed into one contiguous buffer.
+	 * Sections, options, their names and values are stored in flat arrays which reference
+	 * each other by positions, so whole config is a single allocation and its destruction
+	 * is trivial. Sections and options are looked up by minimal perfect hash built
+	 * when the config is frozen, every lookup compares only one name.
+	 * Values keep their stored types, strings are converted on every access.
+	 */
+	class INICPP_API frozen_config
+	{
+	private:
+		/** Section stored in the buffer */
+		struct section_record {
+			/** Position of the name in characters */
+			uint32_t name_offset;
+			/** Length of the name */
+			uint32_t name_length;
+			/** Position of the first option of the section */
+			uint32_t first_option;
+			/** Number of options of the section */
+			uint32_t option_count;
+		};
+		/** Option stored in the buffer */
+		struct option_record {
+			/** Position of the name in characters */
+			uint32_t name_offset;
+			/** Length of the name */
+			uint32_t name_length;
+			/** Position of the first value of the option */
+			uint32_t first_value;
+			/** Number of values of the option */
+			uint32_t value_count;
+			/** Position of the section which contains the option */
+			uint32_t section;
+			/** Index of type of the values in option_value */
+			uint32_t type;
+		};
+		/** Entry of perfect hash table */
+		struct hash_entry {
+			/** Displacement of the bucket which has position of this entry */
+			uint32_t displacement;
+			/** Position of element which belongs to the slot with position of this entry */
+			uint32_t element;
+		};
+		/** Offsets of parts of the buffer in bytes */
+		struct buffer_layout {
+			/** Array of section_record */
+			size_t sections;
+			/** Array of option_record */
+			size_t options;
+			/** Array of values, each stored in 64 bits, strings as position and length of characters */
+			size_t values;
+			/** Perfect hash table of sections */
+			size_t section_table;
+			/** Perfect hash table of options, which are keyed by their section and name */
+			size_t option_table;
+			/** Characters of all names and string values */
+			size_t chars;
+			/** Size of whole buffer */
+			size_t size;
+		};
+
+		/** Returned by lookups if element is not found */
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		/** Whole frozen config */
+		std::unique_ptr<std::byte[]> buffer_;
+		/** Positions of parts of the buffer */
+		buffer_layout layout_;
+		/** Number of sections */
+		uint32_t section_count_;
+		/** Number of options in all sections */
+		uint32_t option_count_;
+
+		/** Index of given type in option_value */
+		template <typename ValueType, size_t Index = 0> static constexpr uint32_t type_of()
+		{
+			if constexpr (std::is_same_v<std::variant_alternative_t<Index, option_value>, ValueType>) {
+				return static_cast<uint32_t>(Index);
+			} else {
+				return type_of<ValueType, Index + 1>();
+			}
+		}
+		/** Array of given type starting at given offset of the buffer */
+		template <typename Record> const Record *part(size_t offset) const
+		{
+			return std::launder(reinterpret_cast<const Record *>(buffer_.get() + offset));
+		}
+		/** Record of section on given position */
+		const section_record &section_at(size_t position) const
+		{
+			return part<section_record>(layout_.sections)[position];
+		}
+		/** Record of option on given position */
+		const option_record &option_at(size_t position) const
+		{
+			return part<option_record>(layout_.options)[position];
+		}
+		/** Stored value on given position */
+		uint64_t value_at(size_t position) const
+		{
+			return part<uint64_t>(layout_.values)[position];
+		}
+		/** Stored characters on given position */
+		std::string_view text(uint32_t offset, uint32_t length) const
+		{
+			return std::string_view(part<char>(layout_.chars) + offset, length);
+		}
+
+		/**
+		 * Append all values of given option to the arrays if they have given type.
+		 * @return true if values were appended
+		 */
+		template <typename ValueType>
+		static bool pack_values(
+			const option &opt, option_record &record, std::vector<uint64_t> &values, std::string &chars);
+		/**
+		 * Find position of section with given name.
+		 * @return position of section record, npos if not found
+		 */
+		size_t find_section(std::string_view section_name) const;
+		/**
+		 * Find position of option with given name in section on given position.
+		 * @return position of option record, npos if not found
+		 */
+		size_t find_option(size_t section_position, std::string_view option_name) const;
+
+		friend class frozen_option;
+		friend class frozen_section;
+
+	public:
+		/** type of const iterator */
+		using const_iterator = frozen_iterator<frozen_config, frozen_section>;
+
+		/**
+		 * Construct empty frozen config.
+		 */
+		frozen_config();
+		/**
+		 * Pack given config into frozen config. Lazily parsed options are parsed now.
+		 * @param cfg frozen configuration, which is not referenced after construction
+		 * @throws ambiguity_exception if names of sections or options of one section are not unique
+		 * @throws exception if names and values exceed 4 GiB or there are more than 2^32 elements
+		 */
+		explicit frozen_config(const config &cfg);
+		/**
+		 * Copy constructor, buffer is copied at once.
+		 */
+		frozen_config(const frozen_config &source);
+		/**
+		 * Copy assignment, buffer is copied at once.
+		 */
+		frozen_config &operator=(const frozen_config &source);
+		/**
+		 * Move constructor.
+		 */
+		frozen_config(frozen_config &&source) noexcept;
+		/**
+		 * Move assignment.
+		 */
+		frozen_config &operator=(frozen_config &&source) noexcept;
+
+		/**
+		 * Get number of sections.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Access section on specified index.
+		 * @param index index of requested section
+		 * @return view of the section
+		 * @throws not_found_exception if index is out of range
+		 */
+		frozen_section operator[](size_t index) const;
+		/**
+		 * Access section with specified name.
+		 * @param section_name name of requested section
+		 * @return view of the section
+		 * @throws not_found_exception if section with given name does not exist
+		 */
+		frozen_section operator[](std::string_view section_name) const;
+		/**
+		 * Determines if section with given name exists.
+		 * @param section_name name of section
+		 * @return true if section exists
+		 */
+		bool contains(std::string_view section_name) const;
+		/**
+		 * Find section with given name without throwing.
+		 * @param section_name name of requested section
+		 * @return view of the section, or empty optional if not found
+		 */
+		std::optional<frozen_section> find(std::string_view section_name) const;
+		/**
+		 * Get converted value of option in specified section without throwing
+		 * on missing section, missing option or failed conversion.
+		 * @param section_name name of section
+		 * @param option_name name of option
+		 * @return converted value, or empty optional if not available
+		 */
+		template <typename ReturnType>
+		std::optional<ReturnType> try_get(std::string_view section_name, std::string_view option_name) const;
+		/**
+		 * Get converted value of option in specified section, or given default
+		 * if it is not available. Never throws on these paths.
+		 * @param section_name name of section
+		 * @param option_name name of option
+		 * @param default_value returned if value is not available
+		 * @return converted value or @a default_value
+		 */
+		template <typename ReturnType>
+		ReturnType get_or(std::string_view section_name, std::string_view option_name, ReturnType default_value) const;
+
+		/**
+		 * Size of the buffer which holds whole frozen config.
+		 * @return number of bytes
+		 */
+		size_t memory_usage() const;
+
+		/**
+		 * Iterator pointing at the first section.
+		 * @return const iterator
+		 */
+		const_iterator begin() const;
+		/**
+		 * Iterator pointing behind the last section.
+		 * @return const iterator
+		 */
+		const_iterator end() const;
+	};
+
+
+	/**
+	 * Read-only view of option of frozen config, which offers the same getters as option.
+	 * View is valid until the frozen config is destroyed or assigned.
+	 */
+	class INICPP_API frozen_option
+	{
+	private:
+		/** Config which contains the option */
+		const frozen_config *config_;
+		/** Record of the option */
+		const frozen_config::option_record *record_;
+
+		/**
+		 * Construct view of given option record.
+		 */
+		frozen_option(const frozen_config &cfg, const frozen_config::option_record &record);
+
+		/**
+		 * Get string value on specified position, values have to be strings or enums.
+		 */
+		std::string_view text(size_t index) const
+		{
+			uint64_t value = config_->value_at(record_->first_value + index);
+			return config_->text(static_cast<uint32_t>(value), static_cast<uint32_t>(value >> 32));
+		}
+		/**
+		 * Get value on specified position, values have to have requested type.
+		 */
+		template <typename ValueType> ValueType stored(size_t index) const
+		{
+			uint64_t value = config_->value_at(record_->first_value + index);
+			if constexpr (std::is_same_v<ValueType, boolean_ini_t>) {
+				return value != 0;
+			} else if constexpr (std::is_same_v<ValueType, signed_ini_t>) {
+				return static_cast<signed_ini_t>(value);
+			} else if constexpr (std::is_same_v<ValueType, unsigned_ini_t>) {
+				return value;
+			} else if constexpr (std::is_same_v<ValueType, float_ini_t>) {
+				float_ini_t result;
+				std::memcpy(&result, &value, sizeof(result));
+				return result;
+			} else {
+				return ValueType(std::string(text(index)));
+			}
+		}
+		/**
+		 * Copy value on specified position into variant.
+		 */
+		option_value value(size_t index) const;
+		/**
+		 * Convert value on specified position to requested type.
+		 * @throws bad_cast_exception if value cannot be converted
+		 */
+		template <typename ReturnType> ReturnType convert(size_t index) const
+		{
+			if (record_->type == frozen_config::type_of<ReturnType>()) { return stored<ReturnType>(index); }
+			if constexpr (std::is_same_v<ReturnType, string_ini_t>) {
+				// convert actual value to string
+				std::string result;
+				string_utils::append_value(result, value(index));
+				return result;
+			} else {
+				if (record_->type == frozen_config::type_of<string_ini_t>()) {
+					try {
+						return string_utils::parse_string<ReturnType>(text(index), get_name());
+					} catch (invalid_type_exception &e) {
+						throw bad_cast_exception(e.what());
+					}
+				}
+				throw bad_cast_exception("Cannot cast to requested type");
+			}
+		}
+
+		friend class frozen_section;
+
+	public:
+		/**
+		 * Gets this option name.
+		 * @return name valid as long as the frozen config
+		 */
+		std::string_view get_name() const;
+		/**
+		 * Number of stored values.
+		 * @return 1 for single value, length of list otherwise
+		 */
+		size_t size() const;
+		/**
+		 * Determines if option is list or not.
+		 * @return true if option is list, false otherwise
+		 */
+		bool is_list() const;
+		/**
+		 * Determines whether values are stored as given type, empty option holds any type.
+		 * @return true if values have given type
+		 */
+		template <typename ValueType> bool holds_type() const
+		{
+			return record_->value_count == 0 || record_->type == frozen_config::type_of<ValueType>();
+		}
+
+		/**
+		 * Get single element value.
+		 * If option value is list, than return first element of array.
+		 * @return templated copy by value
+		 * @throws bad_cast_exception if internal type cannot be casted
+		 * @throws not_found_exception if there is no value
+		 */
+		template <typename ReturnType> ReturnType get() const
+		{
+			if (record_->value_count == 0) { throw not_found_exception(0); }
+			return convert<ReturnType>(0);
+		}
+		/**
+		 * Get single element value without throwing on missing value or failed conversion.
+		 * @return converted value, or empty optional if there is no value
+		 *   or it cannot be converted to requested type
+		 */
+		template <typename ReturnType> std::optional<ReturnType> try_get() const
+		{
+			if (record_->value_count == 0) { return std::nullopt; }
+			if constexpr (!std::is_same_v<ReturnType, string_ini_t>) {
+				if (record_->type != frozen_config::type_of<ReturnType>()) {
+					if (record_->type != frozen_config::type_of<string_ini_t>()) { return std::nullopt; }
+
+					ReturnType result{};
+					if (!string_utils::try_parse_string<ReturnType>(text(0), result)) { return std::nullopt; }
+					return result;
+				}
+			}
+			return convert<ReturnType>(0);
+		}
+		/**
+		 * Get single element value, or given default if there is no value
+		 * or it cannot be converted. Never throws on these paths.
+		 * @param default_value returned if value is not available
+		 * @return converted value or @a default_value
+		 */
+		template <typename ReturnType> ReturnType get_or(ReturnType default_value) const
+		{
+			std::optional<ReturnType> result = try_get<ReturnType>();
+			return result ? std::move(*result) : std::move(default_value);
+		}
+		/**
+		 * Get list of values converted to requested type. Returning list is newly created.
+		 * @return new list of all stored values
+		 * @throws bad_cast_exception if internal type cannot be casted
+		 * @throws not_found_exception if there is no value
+		 */
+		template <typename ReturnType> std::vector<ReturnType> get_list() const
+		{
+			if (record_->value_count == 0) { throw not_found_exception(0); }
+
+			std::vector<ReturnType> results;
+			results.reserve(record_->value_count);
+			for (size_t i = 0; i < record_->value_count; ++i) { results.push_back(convert<ReturnType>(i)); }
+			return results;
+		}
+		/**
+		 * Get value on specified position of the list.
+		 * @param index position of requested value
+		 * @return templated copy by value
+		 * @throws bad_cast_exception if internal type cannot be casted
+		 * @throws not_found_exception if index is out of range
+		 */
+		template <typename ReturnType> ReturnType at(size_t index) const
+		{
+			if (index >= record_->value_count) { throw not_found_exception(index); }
+			return convert<ReturnType>(index);
+		}
+	};
+
+
+	/**
+	 * Read-only view of section of frozen config, which offers the same lookups as section.
+	 * View is valid until the frozen config is destroyed or assigned.
+	 */
+	class INICPP_API frozen_section
+	{
+	private:
+		/** Config which contains the section */
+		const frozen_config *config_;
+		/** Position of the section */
+		size_t position_;
+
+		/**
+		 * Construct view of section on given position.
+		 */
+		frozen_section(const frozen_config &cfg, size_t position);
+
+		/** Record of the section */
+		const frozen_config::section_record &record() const
+		{
+			return config_->section_at(position_);
+		}
+
+		friend class frozen_config;
+
+	public:
+		/** type of const iterator */
+		using const_iterator = frozen_iterator<frozen_section, frozen_option>;
+
+		/**
+		 * Getter for name of this section.
+		 * @return name valid as long as the frozen config
+		 */
+		std::string_view get_name() const;
+		/**
+		 * Returns number of options.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Access option on specified index.
+		 * @param index index of requested option
+		 * @return view of the option
+		 * @throws not_found_exception if index is out of range
+		 */
+		frozen_option operator[](size_t index) const;
+		/**
+		 * Access option with specified name.
+		 * @param option_name name of requested option
+		 * @return view of the option
+		 * @throws not_found_exception if option with given name does not exist
+		 */
+		frozen_option operator[](std::string_view option_name) const;
+		/**
+		 * Determines if option with given name exists.
+		 * @param option_name name of option
+		 * @return true if option exists
+		 */
+		bool contains(std::string_view option_name) const;
+		/**
+		 * Find option with given name without throwing.
+		 * @param option_name name of requested option
+		 * @return view of the option, or empty optional if not found
+		 */
+		std::optional<frozen_option> find(std::string_view option_name) const;
+		/**
+		 * Get converted value of option without throwing on missing option or failed conversion.
+		 * @param option_name name of option
+		 * @return converted value, or empty optional if not available
+		 */
+		template <typename ReturnType> std::optional<ReturnType> try_get(std::string_view option_name) const
+		{
+			std::optional<frozen_option> opt = find(option_name);
+			if (!opt) { return std::nullopt; }
+			return opt->try_get<ReturnType>();
+		}
+		/**
+		 * Get converted value of option, or given default if it is not available.
+		 * @param option_name name of option
+		 * @param default_value returned if value is not available
+		 * @return converted value or @a default_value
+		 */
+		template <typename ReturnType> ReturnType get_or(std::string_view option_name, ReturnType default_value) const
+		{
+			std::optional<frozen_option> opt = find(option_name);
+			if (!opt) { return default_value; }
+			return opt->get_or<ReturnType>(std::move(default_value));
+		}
+
+		/**
+		 * Iterator pointing at the first option.
+		 * @return const iterator
+		 */
+		const_iterator begin() const;
+		/**
+		 * Iterator pointing behind the last option.
+		 * @return const iterator
+		 */
+		const_iterator end() const;
+	};
+
+
+	template <typename ReturnType>
+	std::optional<ReturnType> frozen_config::try_get(
+		std::string_view section_name, std::string_view option_name) const
+	{
+		std::optional<frozen_section> sect = find(section_name);
+		if (!sect) { return std::nullopt; }
+		return sect->try_get<ReturnType>(option_name);
+	}
+
+	template <typename ReturnType>
+	ReturnType frozen_config::get_or(
+		std::string_view section_name, std::string_view option_name, ReturnType default_value) const
+	{
+		std::optional<frozen_section> sect = find(section_name);
+		if (!sect) { return default_value; }
+		return sect->get_or<ReturnType>(option_name, std::move(default_value));
+	}
+} // namespace inicpp
+
+#endif // INICPP_FROZEN_CONFIG_H
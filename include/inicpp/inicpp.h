@@ -6,14 +6,22 @@
  * library from external projekt.
  */
 
+#include "bound_option.h"
 #include "config.h"
 #include "exception.h"
+#include "frozen_config.h"
+#include "load_error.h"
+#include "load_result.h"
 #include "option.h"
 #include "option_schema.h"
+#include "parse_handler.h"
 #include "parser.h"
+#include "push_parser.h"
 #include "schema.h"
 #include "section.h"
 #include "section_schema.h"
+#include "symbol_table.h"
 #include "types.h"
+#include "value_view.h"
 
 #endif // INICPP_MAIN_H
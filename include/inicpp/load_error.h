@@ -0,0 +1,99 @@
+#ifndef INICPP_LOAD_ERROR_H
+#define INICPP_LOAD_ERROR_H
+
+#include <string>
+
+#include "dll.h"
+
+namespace inicpp
+{
+	/**
+	 * Reason why loading of ini configuration failed.
+	 */
+	enum class load_error_code {
+		/** Section header is missing closing bracket */
+		section_not_ended,
+		/** Section header contains no name */
+		empty_section_name,
+		/** Name of section or option contains forbidden characters */
+		invalid_identifier,
+		/** Line is neither section header nor option */
+		option_expected,
+		/** Option appears before the first section header */
+		option_not_in_section,
+		/** Nothing follows the equals sign of the option */
+		empty_option_value,
+		/** Link is not in format ${section#option} */
+		bad_link_format,
+		/** Section name in link is empty */
+		empty_link_section,
+		/** Linked section does not exist */
+		bad_link_section,
+		/** Linked option does not exist */
+		bad_link_option,
+		/** Section with the same name was already defined */
+		duplicate_section,
+		/** Option with the same name was already defined in the section */
+		duplicate_option,
+		/** File cannot be opened */
+		file_not_readable,
+		/** Configuration does not satisfy schema */
+		validation_failed
+	};
+
+
+	/**
+	 * Compact description of the error which made loading fail.
+	 * Message is not stored, it is formatted only when requested.
+	 */
+	class INICPP_API load_error
+	{
+	private:
+		/** Reason of the error */
+		load_error_code code_;
+		/** Line of the error starting from 1, 0 if error is not related to any line */
+		size_t line_;
+		/** Column of the error starting from 1, 0 if error concerns whole line */
+		size_t column_;
+		/** Offset of the error in bytes from the beginning of the input */
+		size_t offset_;
+		/** Name of duplicate element or message of validation error, empty otherwise */
+		std::string detail_;
+
+	public:
+		/**
+		 * Construct error description.
+		 * @param code reason of the error
+		 * @param line line of the error starting from 1, 0 if not related to any line
+		 * @param column column of the error starting from 1, 0 if error concerns whole line
+		 * @param offset offset of the error in bytes from the beginning of the input
+		 * @param detail name of duplicate element or message of validation error
+		 */
+		load_error(load_error_code code, size_t line, size_t column, size_t offset, std::string detail = "");
+
+		/**
+		 * Reason of the error.
+		 */
+		load_error_code code() const;
+		/**
+		 * Line of the error starting from 1, 0 if error is not related to any line.
+		 */
+		size_t line() const;
+		/**
+		 * Column of the error starting from 1, 0 if error concerns whole line.
+		 */
+		size_t column() const;
+		/**
+		 * Offset of the error in bytes from the beginning of the input.
+		 */
+		size_t offset() const;
+		/**
+		 * Format textual description of the error, which is the same as
+		 * the message of exception thrown by parser::load() on the same input.
+		 * @return newly created message
+		 */
+		std::string message() const;
+	};
+} // namespace inicpp
+
+#endif // INICPP_LOAD_ERROR_H
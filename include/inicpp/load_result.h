@@ -0,0 +1,86 @@
+#ifndef INICPP_LOAD_RESULT_H
+#define INICPP_LOAD_RESULT_H
+
+#include <variant>
+
+#include "config.h"
+#include "dll.h"
+#include "load_error.h"
+
+namespace inicpp
+{
+	/**
+	 * Outcome of non-throwing loading of ini configuration,
+	 * holds either loaded config or description of the error.
+	 */
+	class INICPP_API load_result
+	{
+	private:
+		/** Loaded config or the error */
+		std::variant<config, load_error> result_;
+
+	public:
+		/**
+		 * Construct successful result.
+		 * @param cfg loaded configuration
+		 */
+		load_result(config &&cfg);
+		/**
+		 * Construct failed result.
+		 * @param error description of the error
+		 */
+		load_result(load_error error);
+
+		/**
+		 * Determines whether configuration was loaded.
+		 * @return true if result holds config
+		 */
+		bool has_value() const;
+		/**
+		 * Determines whether configuration was loaded.
+		 * @return true if result holds config
+		 */
+		explicit operator bool() const;
+
+		/**
+		 * Access loaded configuration.
+		 * @return modifiable reference to config
+		 * @throws parser_exception with error message if loading failed
+		 */
+		config &value();
+		/**
+		 * Access loaded configuration.
+		 * @return constant reference to config
+		 * @throws parser_exception with error message if loading failed
+		 */
+		const config &value() const;
+		/**
+		 * Access loaded configuration, result has to hold config.
+		 * @return modifiable reference to config
+		 */
+		config &operator*();
+		/**
+		 * Access loaded configuration, result has to hold config.
+		 * @return constant reference to config
+		 */
+		const config &operator*() const;
+		/**
+		 * Access members of loaded configuration, result has to hold config.
+		 * @return pointer to config
+		 */
+		config *operator->();
+		/**
+		 * Access members of loaded configuration, result has to hold config.
+		 * @return constant pointer to config
+		 */
+		const config *operator->() const;
+
+		/**
+		 * Access description of the error, result must not hold config.
+		 * @return constant reference to error
+		 */
+		const load_error &error() const;
+	};
+} // namespace inicpp
+
+#endif // INICPP_LOAD_RESULT_H
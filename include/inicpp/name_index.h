@@ -0,0 +1,255 @@
+#ifndef INICPP_NAME_INDEX_H
+#define INICPP_NAME_INDEX_H
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+
+namespace inicpp
+{
+	/**
+	 * Take new layout generation, which was not returned before in this process.
+	 * @return unique nonzero number
+	 */
+	INICPP_API uint64_t next_layout_generation();
+
+
+	/**
+	 * Flat hash index of named elements stored in a vector of shared pointers.
+	 * Slots of open addressing table with linear probing hold only positions
+	 * of elements in the vector and part of the hash of their names, so lookup
+	 * compares whole names only when the stored hash matches. Order of elements
+	 * is kept by the vector itself, the index has to be updated on every change of it.
+	 * Each index carries layout generation, which is unique among all indexes and changes
+	 * whenever already indexed elements might have been replaced or removed.
+	 * Indexed elements are marked, so that assignment to them keeps their name
+	 * and they stay findable under the name they were indexed by.
+	 * Table is allocated from memory resource given on construction.
+	 */
+	template <typename Element> class name_index
+	{
+	private:
+		/** Slot of the table */
+		struct slot {
+			/** Lower bits of the hash of element name */
+			uint32_t hash;
+			/** Position of element in the vector, empty_slot if slot is free */
+			uint32_t position;
+		};
+
+		/** Position stored in unused slots */
+		static constexpr uint32_t empty_slot = std::numeric_limits<uint32_t>::max();
+		/** Number of slots of the first allocated table */
+		static constexpr size_t min_capacity = 8;
+
+		/** Table with power of two number of slots, empty until the first insert */
+		std::pmr::vector<slot> slots_;
+		/** Number of used slots */
+		size_t size_;
+		/** Layout generation of indexed elements */
+		uint64_t generation_;
+
+		/** Hash of element name */
+		static size_t hash(std::string_view name)
+		{
+			return std::hash<std::string_view>()(name);
+		}
+
+		/**
+		 * Place position into the table, which has to have free slot.
+		 */
+		void place(size_t name_hash, size_t position)
+		{
+			size_t mask = slots_.size() - 1;
+			size_t i = name_hash & mask;
+			while (slots_[i].position != empty_slot) { i = (i + 1) & mask; }
+			slots_[i] = {static_cast<uint32_t>(name_hash), static_cast<uint32_t>(position)};
+			++size_;
+		}
+
+		/**
+		 * Fill newly allocated table with all elements of the vector.
+		 */
+		template <typename Elements> void fill(const Elements &elements)
+		{
+			allocate(elements.size());
+			for (size_t i = 0; i < elements.size(); ++i) {
+				place(hash(elements[i]->get_name()), i);
+				elements[i]->indexed_ = true;
+			}
+		}
+
+		/**
+		 * Allocate empty table which can hold given number of elements
+		 * without exceeding load factor of 3/4.
+		 */
+		void allocate(size_t count)
+		{
+			size_t capacity = min_capacity;
+			while (capacity * 3 < count * 4) { capacity *= 2; }
+			slots_.assign(capacity, slot{0, empty_slot});
+			size_ = 0;
+		}
+
+	public:
+		/** Returned by find() if no element has given name */
+		static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+		/**
+		 * Construct empty index, no memory is allocated.
+		 */
+		name_index() : slots_(), size_(0), generation_(next_layout_generation())
+		{
+		}
+		/**
+		 * Construct empty index which allocates its table from given resource, no memory is allocated now.
+		 * @param resource memory resource which has to outlive the index
+		 */
+		explicit name_index(std::pmr::memory_resource *resource)
+			: slots_(resource), size_(0), generation_(next_layout_generation())
+		{
+		}
+		/**
+		 * Copy constructor, copy indexes different elements so it gets new generation.
+		 */
+		name_index(const name_index &source)
+			: slots_(source.slots_), size_(source.size_), generation_(next_layout_generation())
+		{
+		}
+		/**
+		 * Copy constructor which allocates the table from given resource.
+		 * @param source copied index
+		 * @param resource memory resource which has to outlive the index
+		 */
+		name_index(const name_index &source, std::pmr::memory_resource *resource)
+			: slots_(source.slots_, resource), size_(source.size_), generation_(next_layout_generation())
+		{
+		}
+		/**
+		 * Copy assignment, copy indexes different elements so it gets new generation.
+		 */
+		name_index &operator=(const name_index &source)
+		{
+			slots_ = source.slots_;
+			size_ = source.size_;
+			generation_ = next_layout_generation();
+			return *this;
+		}
+		/**
+		 * Move constructor, takes generation of the source together with its elements.
+		 */
+		name_index(name_index &&source) noexcept
+			: slots_(std::move(source.slots_)), size_(source.size_), generation_(source.generation_)
+		{
+			source.size_ = 0;
+			source.generation_ = next_layout_generation();
+		}
+		/**
+		 * Move assignment, takes generation of the source together with its elements.
+		 */
+		name_index &operator=(name_index &&source) noexcept
+		{
+			if (this != &source) {
+				slots_ = std::move(source.slots_);
+				size_ = source.size_;
+				generation_ = source.generation_;
+				source.slots_.clear();
+				source.size_ = 0;
+				source.generation_ = next_layout_generation();
+			}
+			return *this;
+		}
+
+		/**
+		 * Layout generation, equal generations guarantee that elements
+		 * found before are still stored in the indexed vector.
+		 * @return unique nonzero number
+		 */
+		uint64_t generation() const
+		{
+			return generation_;
+		}
+
+		/**
+		 * Find element with given name.
+		 * @param name name of the element
+		 * @param elements indexed vector
+		 * @return position of the element in @a elements, npos if not found
+		 */
+		template <typename Elements> size_t find(std::string_view name, const Elements &elements) const
+		{
+			if (size_ == 0) { return npos; }
+
+			size_t name_hash = hash(name);
+			size_t mask = slots_.size() - 1;
+			for (size_t i = name_hash & mask; slots_[i].position != empty_slot; i = (i + 1) & mask) {
+				const slot &current = slots_[i];
+				if (current.hash == static_cast<uint32_t>(name_hash) &&
+					elements[current.position]->get_name() == name) {
+					return current.position;
+				}
+			}
+			return npos;
+		}
+
+		/**
+		 * Add element which was appended to the end of indexed vector.
+		 * Name of the element must not be present in the index.
+		 * @param elements indexed vector with the new element at the end
+		 */
+		template <typename Elements> void push_back(const Elements &elements)
+		{
+			if ((size_ + 1) * 4 > slots_.size() * 3) {
+				// grown table is filled again from the vector, which holds all names,
+				//   appending does not touch other elements so generation stays
+				fill(elements);
+			} else {
+				place(hash(elements.back()->get_name()), elements.size() - 1);
+				elements.back()->indexed_ = true;
+			}
+		}
+
+		/**
+		 * Mark copies of elements, which are indexed by copy of this index.
+		 * @param elements indexed vector
+		 */
+		template <typename Elements> static void adopt(const Elements &elements)
+		{
+			for (auto &element : elements) { element->indexed_ = true; }
+		}
+
+		/**
+		 * Build the index again from all elements of the vector,
+		 * which is needed after removal of elements, because positions are shifted.
+		 * @param elements indexed vector
+		 */
+		template <typename Elements> void rebuild(const Elements &elements)
+		{
+			if (elements.empty()) {
+				clear();
+				return;
+			}
+			fill(elements);
+			generation_ = next_layout_generation();
+		}
+
+		/**
+		 * Remove all elements and release the table.
+		 */
+		void clear()
+		{
+			slots_.clear();
+			slots_.shrink_to_fit();
+			size_ = 0;
+			generation_ = next_layout_generation();
+		}
+	};
+} // namespace inicpp
+
+#endif // INICPP_NAME_INDEX_H
@@ -1,9 +1,13 @@
 #ifndef INICPP_OPTION_H
 #define INICPP_OPTION_H
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 #include "dll.h"
@@ -11,64 +15,55 @@
 #include "option_schema.h"
 #include "string_utils.h"
 #include "types.h"
+#include "value_list.h"
+#include "value_view.h"
 
 
 namespace inicpp
 {
 	/** Forward declaration, stated because of ring dependencies */
 	class option_schema;
+	/** Forward declaration of internal handler which creates lazy options */
+	class config_builder;
+	/** Forward declaration of internal writer of ini configuration */
+	class serializer;
+	/** Forward declaration of storage of shared names and values */
+	class symbol_table;
+	/** Forward declaration of typed binding, which watches modifications of option */
+	template <typename ValueType> class bound_option;
 
 
 	namespace
 	{
-		std::string escape_option_value(const std::string &str)
-		{
-			std::string result(str);
-			if (str.length() > 0 && std::isspace(result[0])) { result.insert(result.begin(), '\\'); }
-			if (str.length() > 1 && std::isspace(result[result.length() - 1])) {
-				result.insert(result.end() - 1, '\\');
-			}
-
-			return result;
-		}
-
 		template <typename ReturnType>
-		ReturnType convert_single_value(const option_value &value, const std::string &name)
+		ReturnType convert_single_value(const value_list &values, size_t index, const std::string &name)
 		{
-			if (std::holds_alternative<string_ini_t>(value) && !std::is_same_v<string_ini_t, ReturnType>) {
+			if (values.holds<ReturnType>()) {
+				// Return the requested type
+				return values.get<ReturnType>(index);
+			} else if (values.holds<string_ini_t>()) {
 				// Try to parse the value (have string, want typed value)
 				try {
-					auto v = std::get<string_ini_t>(value);
-					return string_utils::parse_string<ReturnType>(v, name);
+					return string_utils::parse_string<ReturnType>(std::string(values.string_at(index)), name);
 				} catch (invalid_type_exception &e) {
 					throw bad_cast_exception(e.what());
 				}
-			} else {
-				// Try to return the requested type
-				return std::get<ReturnType>(value);
 			}
+			throw bad_cast_exception("Cannot cast to requested type");
 		}
 
-		template <> string_ini_t convert_single_value(const option_value &value, const std::string &)
+		template <> string_ini_t convert_single_value(const value_list &values, size_t index, const std::string &)
 		{
 			// disable compiler warning that this function is unused when building the library
 			(void) convert_single_value<string_ini_t>;
 
-			try {
-				// Try to return the strign
-				return std::get<string_ini_t>(value);
-			} catch (const std::bad_variant_access &) {
-				// It didn't work, convert actual value to string
-				std::stringstream s;
-				std::visit(overloaded{[&](boolean_ini_t x) { s << (x ? "yes" : "no"); },
-							   [&](enum_ini_t x) { s << escape_option_value(static_cast<std::string>(x)); },
-							   [&](float_ini_t x) { s << x; },
-							   [&](signed_ini_t x) { s << x; },
-							   [&](unsigned_ini_t x) { s << x; },
-							   [&](string_ini_t x) { s << escape_option_value(x); }},
-					value);
-				return s.str();
-			}
+			// Try to return the string
+			if (values.holds<string_ini_t>()) { return values.get<string_ini_t>(index); }
+
+			// It didn't work, convert actual value to string
+			std::string result;
+			string_utils::append_value(result, values[index]);
+			return result;
 		}
 	} // namespace
 
@@ -80,12 +75,109 @@ namespace inicpp
 	class INICPP_API option
 	{
 	private:
-		/** Name of this ini option */
+		/** Name of this ini option, empty if it is interned */
 		std::string name_;
-		/** Values which corresponds with this option */
-		std::vector<option_value> values_;
-		/** Corresponding option_schema if any */
-		std::shared_ptr<option_schema> option_schema_;
+		/** Name interned in symbol table, nullptr if name_ is used */
+		const std::string *symbol_;
+		/**
+		 * Values which corresponds with this option. If lazy_ is set, it holds single string
+		 * with unparsed text of the value as written in ini configuration, which is parsed on first access.
+		 */
+		mutable value_list values_;
+		/** True if values_ hold unparsed raw value */
+		mutable std::atomic<bool> lazy_;
+		/** True if option is stored in section, assignment keeps its name then */
+		bool indexed_ = false;
+		/** Number of modifications of values, lets bound options detect that their cached value is stale */
+		uint64_t version_;
+		/**
+		 * String values converted to the type which was requested first, nullptr if not converted yet.
+		 * Empty list marks that the conversion failed, so it is not attempted again.
+		 */
+		mutable std::atomic<value_list *> typed_values_;
+
+		/** Tag which selects constructor of lazily parsed option */
+		struct lazy_tag {
+		};
+
+		/**
+		 * Construct option which parses given raw text into values on first access.
+		 * @param name name of newly created option
+		 * @param raw_value value as written in ini configuration, without comment
+		 */
+		option(std::string name, std::string_view raw_value, lazy_tag);
+		/**
+		 * Parse raw value into list of values if it was not done yet.
+		 * Safe to be called concurrently on the same option.
+		 */
+		void materialize() const;
+		/**
+		 * Drop all values including unparsed raw value.
+		 */
+		void clear_values();
+		/**
+		 * Remember values converted from strings. Only the first conversion
+		 * is stored, so readers never see the cache replaced under their hands.
+		 * @param typed converted values, ownership is taken
+		 */
+		void store_typed_values(value_list *typed) const;
+		/**
+		 * Drop remembered converted values and count the modification,
+		 * has to be called on every modification.
+		 */
+		void invalidate_typed_values();
+		/**
+		 * Get values converted to requested type, if they were remembered.
+		 * @return remembered values or nullptr
+		 */
+		template <typename ValueType> const value_list *typed_values() const
+		{
+			const value_list *typed = typed_values_.load(std::memory_order_acquire);
+			return (typed != nullptr && !typed->empty() && typed->holds<ValueType>() ? typed : nullptr);
+		}
+		/**
+		 * Convert all string values to requested type and remember them, if no conversion
+		 * was remembered yet. Failed conversion is remembered too, nothing is thrown.
+		 */
+		template <typename ValueType> void remember_conversion() const
+		{
+			if (typed_values_.load(std::memory_order_acquire) != nullptr) { return; }
+
+			std::vector<ValueType> converted;
+			converted.reserve(values_.size());
+			for (size_t i = 0; i < values_.size(); ++i) {
+				ValueType value{};
+				if (!string_utils::try_parse_string<ValueType>(values_.string_at(i), value)) {
+					store_typed_values(new value_list());
+					return;
+				}
+				converted.push_back(std::move(value));
+			}
+			store_typed_values(new value_list(std::move(converted)));
+		}
+		/**
+		 * Get view of given values, list has to hold requested type.
+		 * Values are viewed in place except single short string or shared enum, which is copied into the view.
+		 */
+		template <typename ValueType> static value_view<ValueType> view_of(const value_list &values)
+		{
+			if constexpr (std::is_same_v<ValueType, boolean_ini_t>) {
+				static const std::vector<boolean_ini_t> single_true(1, true);
+				static const std::vector<boolean_ini_t> single_false(1, false);
+				if (auto stored = values.array<boolean_ini_t>()) { return value_view<boolean_ini_t>(*stored); }
+				if (values.empty()) { return value_view<boolean_ini_t>(); }
+				return value_view<boolean_ini_t>(values.get<boolean_ini_t>(0) ? single_true : single_false);
+			} else {
+				if (auto first = values.data<ValueType>()) { return value_view<ValueType>(first, values.size()); }
+				if (values.empty()) { return value_view<ValueType>(); }
+				return value_view<ValueType>(std::in_place, values.get<ValueType>(0));
+			}
+		}
+
+		friend class config_builder;
+		friend class serializer;
+		template <typename ValueType> friend class bound_option;
+		template <typename Element> friend class name_index;
 
 	public:
 		/**
@@ -97,7 +189,7 @@ namespace inicpp
 		 */
 		option(const option &source);
 		/**
-		 * Copy assignment.
+		 * Copy assignment. Option stored in section keeps its name, which it is found by.
 		 */
 		option &operator=(const option &source);
 		/**
@@ -105,22 +197,32 @@ namespace inicpp
 		 */
 		option(option &&source);
 		/**
-		 * Move assignment.
+		 * Move assignment. Option stored in section keeps its name, which it is found by.
 		 */
 		option &operator=(option &&source);
+		/**
+		 * Destructor.
+		 */
+		~option();
 
 		/**
 		 * Construct ini option with specified value of specified type.
 		 * @param name name of newly created option
 		 * @param value initial value
 		 */
-		option(const std::string &name, const std::string &value = "");
+		option(std::string name, std::string value = "");
 		/**
 		 * Construct ini option with specified value of specified list type.
 		 * @param name name of newly created option
 		 * @param values initial value
 		 */
-		option(const std::string &name, const std::vector<std::string> &values);
+		option(std::string name, const std::vector<std::string> &values);
+		/**
+		 * Construct ini option with specified value of specified list type.
+		 * @param name name of newly created option
+		 * @param values initial value, strings are moved into the option
+		 */
+		option(std::string name, std::vector<std::string> &&values);
 
 		/**
 		 * Gets this option name.
@@ -134,8 +236,8 @@ namespace inicpp
 		 */
 		template <typename ValueType> bool holds_type() const
 		{
-			if (values_.empty()) { return true; }
-			return std::holds_alternative<ValueType>(values_[0]);
+			materialize();
+			return values_.empty() || values_.holds<ValueType>();
 		}
 		/**
 		 * Determines if option is list or not.
@@ -151,7 +253,7 @@ namespace inicpp
 		 */
 		template <typename ValueType> void set(ValueType value)
 		{
-			this->operator=(value);
+			this->operator=(std::move(value));
 		}
 		/**
 		 * Overloaded alias for set() function.
@@ -199,16 +301,66 @@ namespace inicpp
 		/**
 		 * Get single element value.
 		 * If option value is list, than return first element of array.
+		 * Conversion of string values is remembered until the option is modified.
 		 * @return templated copy by value
 		 * @throws bad_cast_exception if internal type cannot be casted
 		 * @throws not_found_exception if there is no value
 		 */
 		template <typename ReturnType> ReturnType get() const
 		{
+			materialize();
 			if (values_.empty()) { throw not_found_exception(0); }
 
+			if constexpr (!std::is_same_v<ReturnType, string_ini_t>) {
+				if (values_.holds<string_ini_t>()) {
+					if (const value_list *typed = typed_values<ReturnType>()) { return typed->get<ReturnType>(0); }
+
+					// Convert the value, whole list is converted for next calls if nothing was remembered yet
+					ReturnType result = convert_single_value<ReturnType>(values_, 0, get_name());
+					remember_conversion<ReturnType>();
+					return result;
+				}
+			}
+
 			// Get the value and try to convert it
-			return convert_single_value<ReturnType>(values_[0], get_name());
+			return convert_single_value<ReturnType>(values_, 0, get_name());
+		}
+
+		/**
+		 * Get single element value without throwing on missing value or failed conversion.
+		 * If option value is list, than return first element of array.
+		 * @return converted value, or empty optional if there is no value
+		 *   or it cannot be converted to requested type
+		 */
+		template <typename ReturnType> std::optional<ReturnType> try_get() const
+		{
+			materialize();
+			if (values_.empty()) { return std::nullopt; }
+
+			if constexpr (std::is_same_v<ReturnType, string_ini_t>) {
+				return convert_single_value<string_ini_t>(values_, 0, get_name());
+			} else {
+				if (values_.holds<ReturnType>()) { return values_.get<ReturnType>(0); }
+
+				if (!values_.holds<string_ini_t>()) { return std::nullopt; }
+				if (const value_list *typed = typed_values<ReturnType>()) { return typed->get<ReturnType>(0); }
+
+				ReturnType result{};
+				if (!string_utils::try_parse_string<ReturnType>(values_.string_at(0), result)) { return std::nullopt; }
+				return result;
+			}
+		}
+
+		/**
+		 * Get single element value, or given default if there is no value
+		 * or it cannot be converted. Never throws on these paths.
+		 * @param default_value returned if value is not available
+		 * @return converted value or @a default_value
+		 */
+		template <typename ReturnType> ReturnType get_or(ReturnType default_value) const
+		{
+			std::optional<ReturnType> result = try_get<ReturnType>();
+			return result ? std::move(*result) : std::move(default_value);
 		}
 
 		/**
@@ -221,29 +373,96 @@ namespace inicpp
 		 */
 		template <typename ValueType> void set_list(const std::vector<ValueType> &list)
 		{
-			values_.clear();
+			clear_values();
 			for (auto &&item : list) { add_to_list(static_cast<ValueType>(item)); }
 		}
 
 		/**
 		 * Get list of internal values. Returning list is newly created.
 		 * If option contains single value than its returned list
-		 *   with one element.
+		 *   with one element. Conversion of string values is remembered
+		 *   until the option is modified.
 		 * @return new list of all stored values
 		 * @throws bad_cast_exception if internal type cannot be casted
 		 * @throws not_found_exception if there is no value
 		 */
 		template <typename ReturnType> std::vector<ReturnType> get_list() const
 		{
+			materialize();
 			if (values_.empty()) { throw not_found_exception(0); }
+
+			if (values_.holds<ReturnType>()) { return values_.to_vector<ReturnType>(); }
+			if constexpr (!std::is_same_v<ReturnType, string_ini_t>) {
+				if (const value_list *typed = typed_values<ReturnType>()) { return typed->to_vector<ReturnType>(); }
+			}
+
 			std::vector<ReturnType> results;
-			for (const auto &value : values_) {
-				results.push_back(convert_single_value<ReturnType>(value, get_name()));
+			results.reserve(values_.size());
+			for (size_t i = 0; i < values_.size(); ++i) {
+				results.push_back(convert_single_value<ReturnType>(values_, i, get_name()));
 			}
 
+			if constexpr (!std::is_same_v<ReturnType, string_ini_t>) {
+				if (values_.holds<string_ini_t>() && typed_values_.load(std::memory_order_acquire) == nullptr) {
+					store_typed_values(new value_list(results));
+				}
+			}
 			return results;
 		}
 
+		/**
+		 * Get view of all stored values converted to requested type.
+		 * Nothing is allocated if values already hold the type or their conversion
+		 * is remembered, otherwise string values are converted once and remembered
+		 * like in get_list(). If option contains single value than view has one element.
+		 * @return view of values, valid until this option is modified
+		 * @throws bad_cast_exception if values cannot be converted to requested type
+		 */
+		template <typename ValueType> value_view<ValueType> values() const
+		{
+			materialize();
+			if (values_.empty()) { return value_view<ValueType>(); }
+			if (values_.holds<ValueType>()) { return view_of<ValueType>(values_); }
+
+			if constexpr (!std::is_same_v<ValueType, string_ini_t>) {
+				if (!values_.holds<string_ini_t>()) { throw bad_cast_exception("Cannot cast to requested type"); }
+				if (const value_list *typed = typed_values<ValueType>()) { return view_of<ValueType>(*typed); }
+			}
+
+			// conversion is stored in the option if it is the first one, otherwise view keeps its own copy
+			std::vector<ValueType> converted = get_list<ValueType>();
+			if constexpr (!std::is_same_v<ValueType, string_ini_t>) {
+				if (const value_list *typed = typed_values<ValueType>()) { return view_of<ValueType>(*typed); }
+			}
+			return value_view<ValueType>(std::make_shared<const std::vector<ValueType>>(std::move(converted)));
+		}
+
+		/**
+		 * Number of stored values.
+		 * @return 1 for single value, length of list otherwise
+		 */
+		size_t size() const;
+		/**
+		 * Get value on specified position of the list.
+		 * Conversion of string values is remembered until the option is modified.
+		 * @param index position of requested value
+		 * @return templated copy by value
+		 * @throws bad_cast_exception if internal type cannot be casted
+		 * @throws not_found_exception if index is out of range
+		 */
+		template <typename ReturnType> ReturnType at(size_t index) const
+		{
+			materialize();
+			if (index >= values_.size()) { throw not_found_exception(index); }
+
+			if constexpr (!std::is_same_v<ReturnType, string_ini_t>) {
+				if (values_.holds<string_ini_t>()) {
+					if (const value_list *typed = typed_values<ReturnType>()) { return typed->get<ReturnType>(index); }
+				}
+			}
+			return convert_single_value<ReturnType>(values_, index, get_name());
+		}
+
 		/**
 		 * Adds element to internal value list.
 		 * If option was single value than its transformed to list.
@@ -253,8 +472,8 @@ namespace inicpp
 		template <typename ValueType> void add_to_list(ValueType value)
 		{
 			if (!holds_type<ValueType>()) { throw bad_cast_exception("Cannot cast to requested type"); }
-			option_value new_option_value = value;
-			values_.push_back(std::move(new_option_value));
+			invalidate_typed_values();
+			values_.push_back<ValueType>(std::move(value));
 		}
 
 		/**
@@ -269,9 +488,8 @@ namespace inicpp
 		{
 			if (!holds_type<ValueType>()) { throw bad_cast_exception("Cannot cast to requested type"); }
 			if (position > values_.size()) { throw not_found_exception(position); }
-			option_value new_option_value = value;
-			auto p = static_cast<std::iterator_traits<decltype(values_.begin())>::difference_type>(position);
-			values_.insert(std::next(values_.begin(), p), std::move(new_option_value));
+			invalidate_typed_values();
+			values_.insert<ValueType>(std::move(value), position);
 		}
 
 		/**
@@ -282,12 +500,8 @@ namespace inicpp
 		template <typename ValueType> void remove_from_list(ValueType value)
 		{
 			if (!holds_type<ValueType>()) { throw bad_cast_exception("Cannot cast to requested type"); }
-			for (auto it = values_.cbegin(); it != values_.cend(); ++it) {
-				if (std::get<ValueType>(*it) == value) {
-					values_.erase(it);
-					break;
-				}
-			}
+			invalidate_typed_values();
+			values_.remove<ValueType>(value);
 		}
 
 		/**
@@ -297,6 +511,13 @@ namespace inicpp
 		 */
 		void remove_from_list_pos(size_t position);
 
+		/**
+		 * Share name and single long string value of this option with other options
+		 * through given symbol table. Equal interned names are then compared by address.
+		 * @param symbols table which has to outlive this option and all its copies
+		 */
+		void intern(symbol_table &symbols);
+
 		/**
 		 * Validate this option against given option_schema.
 		 * @param opt_schema validation schema
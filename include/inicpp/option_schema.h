@@ -61,6 +61,10 @@ namespace inicpp
 	private:
 		/** Internal properties of the option */
 		schema_params_t params_;
+		/** True if option schema is stored in section schema, assignment keeps its name then */
+		bool indexed_ = false;
+
+		template <typename Element> friend class name_index;
 
 		/**
 		 * Run provided validator on all items in option.
@@ -128,7 +132,7 @@ namespace inicpp
 		 * Get name of this option.
 		 * @return constant reference
 		 */
-		std::string get_name() const;
+		const std::string &get_name() const;
 		/**
 		 * Gets type of option.
 		 * @return option_type structure
@@ -0,0 +1,91 @@
+#ifndef INICPP_PARSE_HANDLER_H
+#define INICPP_PARSE_HANDLER_H
+
+#include <string_view>
+#include <vector>
+
+#include "dll.h"
+#include "exception.h"
+#include "load_error.h"
+
+namespace inicpp
+{
+	/** Forward declaration of internal tokenizer which drives the handler */
+	class tokenizer;
+
+	/**
+	 * Receiver of events produced by event based parsing through parser::parse().
+	 * No config is built, elements are reported in the order they appear in input.
+	 * All passed strings are views which are valid only during the call,
+	 * values are already unescaped but links are not resolved.
+	 * Every event can stop the parsing by returning false.
+	 */
+	class INICPP_API parse_handler
+	{
+	private:
+		/** Number of the line which is currently processed */
+		size_t line_number_;
+		/** Offset of the beginning of currently processed line in bytes */
+		size_t line_offset_;
+
+		friend class tokenizer;
+
+	public:
+		/**
+		 * Default constructor.
+		 */
+		parse_handler();
+		/**
+		 * Virtual destructor.
+		 */
+		virtual ~parse_handler();
+
+		/**
+		 * Called for every section header.
+		 * @param name unescaped and validated name of the section
+		 * @return true if parsing should continue
+		 */
+		virtual bool on_section(std::string_view name);
+		/**
+		 * Called for every option, which is always inside some section.
+		 * @param name unescaped and validated name of the option
+		 * @param values unescaped values of the option, at least one
+		 * @return true if parsing should continue
+		 */
+		virtual bool on_option(std::string_view name, const std::vector<std::string_view> &values);
+		/**
+		 * Called for every comment, after the element on the same line.
+		 * @param comment text following the comment character
+		 * @return true if parsing should continue
+		 */
+		virtual bool on_comment(std::string_view comment);
+		/**
+		 * Called for every malformed line. Default implementation throws
+		 * given exception, so that parsing fails the same way as parser::load().
+		 * @param error description of the error
+		 * @return true if parsing should continue with the next line
+		 */
+		virtual bool on_error(const parser_exception &error);
+		/**
+		 * Called for every malformed line with compact description of the error.
+		 * Default implementation formats the message and passes it to on_error(),
+		 * handlers which do not need the message can avoid its formatting.
+		 * @param error description of the error
+		 * @return true if parsing should continue with the next line
+		 */
+		virtual bool on_load_error(const load_error &error);
+
+		/**
+		 * Number of the line which contains currently reported element.
+		 * @return line number starting from 1
+		 */
+		size_t line_number() const;
+		/**
+		 * Offset of the beginning of the line which contains currently reported element.
+		 * @return offset in bytes from the beginning of the input
+		 */
+		size_t line_offset() const;
+	};
+} // namespace inicpp
+
+#endif // INICPP_PARSE_HANDLER_H
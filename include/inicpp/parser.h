@@ -3,15 +3,19 @@
 
 #include <fstream>
 #include <iostream>
-#include <regex>
+#include <memory_resource>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "config.h"
 #include "dll.h"
 #include "exception.h"
+#include "load_result.h"
+#include "parse_handler.h"
 #include "schema.h"
 #include "string_utils.h"
+#include "symbol_table.h"
 
 namespace inicpp
 {
@@ -22,28 +26,18 @@ namespace inicpp
 	class INICPP_API parser
 	{
 	private:
-		/**
-		 * Finds first nonescaped character given as parameter
-		 * Escaping character is '\'
-		 * @return std::string::npos if not found
-		 */
-		static size_t find_first_nonescaped(const std::string &str, char ch);
-		/**
-		 * Finds last escaped character given as parameter
-		 * Escaping character is '\'
-		 * @return std::string::npos if not found
-		 */
-		static size_t find_last_escaped(const std::string &str, char ch);
-		static std::string unescape(const std::string &str);
-		static std::string delete_comment(const std::string &str);
-		static std::vector<std::string> parse_option_list(const std::string &str);
-		static void handle_links(const config &cfg,
-			const section &last_section,
-			std::vector<std::string> &option_val_list,
-			size_t line_number);
-		static void validate_identifier(const std::string &str, size_t line_number);
-
-		static config internal_load(std::istream &str);
+		static config internal_load(std::istream &str,
+			bool lazy = false,
+			std::pmr::memory_resource *resource = std::pmr::get_default_resource(),
+			symbol_table *symbols = nullptr);
+		static config internal_load(const char *data,
+			size_t length,
+			bool lazy = false,
+			std::pmr::memory_resource *resource = std::pmr::get_default_resource(),
+			symbol_table *symbols = nullptr);
+		static config internal_load_parallel(const char *data, size_t length, size_t threads);
+		static load_result internal_try_load(std::istream &str);
+		static load_result internal_try_load(const char *data, size_t length);
 		static void internal_save(const config &cfg, const schema &schm, std::ostream &str);
 
 	public:
@@ -75,6 +69,25 @@ namespace inicpp
 		 * @throws parser_exception if ini configuration is wrong
 		 */
 		static config load(const std::string &str);
+		/**
+		 * Load ini configuration from given string into given memory resource.
+		 * Sections and options of returned config are allocated from the resource,
+		 * so it can be monotonic arena released at once after the config is destroyed.
+		 * @param str ini configuration description
+		 * @param resource memory resource which has to outlive returned config
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load(const std::string &str, std::pmr::memory_resource *resource);
+		/**
+		 * Load ini configuration from given string, names and values are interned into given table.
+		 * Configs loaded with the same table share storage of equal names and long values.
+		 * @param str ini configuration description
+		 * @param symbols symbol table which has to outlive returned config
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load(const std::string &str, symbol_table &symbols);
 		/**
 		 * Load ini configuration from given string
 		 * and validate it through schema.
@@ -93,6 +106,22 @@ namespace inicpp
 		 * @throws parser_exception if ini configuration is wrong
 		 */
 		static config load(std::istream &str);
+		/**
+		 * Load ini configuration from given stream into given memory resource.
+		 * @param str ini configuration description
+		 * @param resource memory resource which has to outlive returned config
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load(std::istream &str, std::pmr::memory_resource *resource);
+		/**
+		 * Load ini configuration from given stream, names and values are interned into given table.
+		 * @param str ini configuration description
+		 * @param symbols symbol table which has to outlive returned config
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load(std::istream &str, symbol_table &symbols);
 		/**
 		 * Load ini configuration from given stream
 		 * and validate it through schema.
@@ -104,6 +133,30 @@ namespace inicpp
 		 * @throws validation_exception if configuration does not comply schema
 		 */
 		static config load(std::istream &str, const schema &schm, schema_mode mode);
+		/**
+		 * Load ini configuration from given string using multiple threads.
+		 * Input is split at section headers, chunks are parsed in parallel
+		 * and merged in original order, links are resolved after the merge.
+		 * Result is identical to load(), including reported errors.
+		 * @param str ini configuration description
+		 * @param threads number of used threads, 0 means hardware concurrency
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 * @throws ambiguity_exception if section names are duplicated
+		 */
+		static config load_parallel(const std::string &str, size_t threads = 0);
+		/**
+		 * Load ini configuration from given string using multiple threads
+		 * and validate it through schema.
+		 * @param str ini configuration description
+		 * @param threads number of used threads, 0 means hardware concurrency
+		 * @param schm validation schema
+		 * @param mode validation mode
+		 * @return constructed config class which comply given schema
+		 * @throws parser_exception if ini configuration is wrong
+		 * @throws validation_exception if configuration does not comply schema
+		 */
+		static config load_parallel(const std::string &str, size_t threads, const schema &schm, schema_mode mode);
 
 		/**
 		 * Load ini configuration from file with specified name.
@@ -112,6 +165,22 @@ namespace inicpp
 		 * @throws parser_exception if ini configuration is wrong
 		 */
 		static config load_file(const std::string &file);
+		/**
+		 * Load ini configuration from file with specified name into given memory resource.
+		 * @param file name of file which contains ini configuration
+		 * @param resource memory resource which has to outlive returned config
+		 * @return new instance of config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load_file(const std::string &file, std::pmr::memory_resource *resource);
+		/**
+		 * Load ini configuration from file with specified name, names and values are interned into given table.
+		 * @param file name of file which contains ini configuration
+		 * @param symbols symbol table which has to outlive returned config
+		 * @return new instance of config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load_file(const std::string &file, symbol_table &symbols);
 		/**
 		 * Load ini configuration from file with specified name
 		 * and validate it against given schema.
@@ -123,6 +192,134 @@ namespace inicpp
 		 * @throws validation_exception if configuration does not comply schema
 		 */
 		static config load_file(const std::string &file, const schema &schm, schema_mode mode);
+		/**
+		 * Load ini configuration from file with specified name. File is mapped
+		 * into memory and parsed directly from mapped pages, which avoids
+		 * copying of whole content through stream buffers. If mapping
+		 * is not possible, file is read through standard stream instead.
+		 * Resulting config is the same as from load_file().
+		 * @param file name of file which contains ini configuration
+		 * @return new instance of config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load_file_mapped(const std::string &file);
+		/**
+		 * Load ini configuration from memory mapped file with specified name
+		 * and validate it against given schema.
+		 * @param file name of file with ini configuration
+		 * @param schm validation schema
+		 * @param mode validation mode
+		 * @return new instance of config class
+		 * @throws parser_exception if ini configuration is wrong
+		 * @throws validation_exception if configuration does not comply schema
+		 */
+		static config load_file_mapped(const std::string &file, const schema &schm, schema_mode mode);
+
+		/**
+		 * Load ini configuration from given string in lazy mode. Structure of the
+		 * configuration is checked right away, but values of options are kept as raw
+		 * text and split into unescaped values on first access. Options which can
+		 * contain links are parsed during loading, so all errors are reported
+		 * the same way as by load().
+		 * @param str ini configuration description
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load_lazy(const std::string &str);
+		/**
+		 * Load ini configuration from given stream in lazy mode.
+		 * @param str ini configuration description
+		 * @return newly created config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load_lazy(std::istream &str);
+		/**
+		 * Load ini configuration from file with specified name in lazy mode.
+		 * File is memory mapped if possible, read through stream otherwise.
+		 * @param file name of file which contains ini configuration
+		 * @return new instance of config class
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		static config load_file_lazy(const std::string &file);
+
+		/**
+		 * Load ini configuration from given string without throwing on malformed input.
+		 * Parsing stops on the first error, whose message is formatted only on request.
+		 * @param str ini configuration description
+		 * @return loaded config or description of the error
+		 */
+		static load_result try_load(const std::string &str);
+		/**
+		 * Load ini configuration from given string and validate it against schema
+		 * without throwing on malformed input or validation failure.
+		 * @param str ini configuration description
+		 * @param schm validation schema
+		 * @param mode validation mode
+		 * @return loaded config or description of the error
+		 */
+		static load_result try_load(const std::string &str, const schema &schm, schema_mode mode);
+		/**
+		 * Load ini configuration from given stream without throwing on malformed input.
+		 * @param str ini configuration description
+		 * @return loaded config or description of the error
+		 */
+		static load_result try_load(std::istream &str);
+		/**
+		 * Load ini configuration from given stream and validate it against schema
+		 * without throwing on malformed input or validation failure.
+		 * @param str ini configuration description
+		 * @param schm validation schema
+		 * @param mode validation mode
+		 * @return loaded config or description of the error
+		 */
+		static load_result try_load(std::istream &str, const schema &schm, schema_mode mode);
+		/**
+		 * Load ini configuration from file with specified name without throwing
+		 * on malformed input or if file cannot be read. File is memory mapped if possible.
+		 * @param file name of file which contains ini configuration
+		 * @return loaded config or description of the error
+		 */
+		static load_result try_load_file(const std::string &file);
+		/**
+		 * Load ini configuration from file with specified name and validate it against schema
+		 * without throwing on malformed input, validation failure or if file cannot be read.
+		 * @param file name of file which contains ini configuration
+		 * @param schm validation schema
+		 * @param mode validation mode
+		 * @return loaded config or description of the error
+		 */
+		static load_result try_load_file(const std::string &file, const schema &schm, schema_mode mode);
+
+		/**
+		 * Parse ini configuration from given string without building config.
+		 * Parsed elements are reported to given handler in order of appearance.
+		 * @param str ini configuration description
+		 * @param handler receiver of parsed elements
+		 * @return false if parsing was stopped by the handler
+		 * @throws parser_exception if ini configuration is wrong and handler does not override on_error()
+		 *   or on_load_error()
+		 */
+		static bool parse(const std::string &str, parse_handler &handler);
+		/**
+		 * Parse ini configuration from given stream without building config.
+		 * Only one line is held in memory at a time.
+		 * @param str ini configuration description
+		 * @param handler receiver of parsed elements
+		 * @return false if parsing was stopped by the handler
+		 * @throws parser_exception if ini configuration is wrong and handler does not override on_error()
+		 *   or on_load_error()
+		 */
+		static bool parse(std::istream &str, parse_handler &handler);
+		/**
+		 * Parse ini configuration from file with specified name without building config.
+		 * File is memory mapped if possible, read through stream otherwise.
+		 * @param file name of file which contains ini configuration
+		 * @param handler receiver of parsed elements
+		 * @return false if parsing was stopped by the handler
+		 * @throws parser_exception if file cannot be read or ini configuration is wrong
+		 *   and handler does not override on_error() or on_load_error()
+		 */
+		static bool parse_file(const std::string &file, parse_handler &handler);
 
 		/**
 		 * Save given configuration to file.
@@ -130,6 +327,13 @@ namespace inicpp
 		 * @param file name of output file
 		 */
 		static void save(const config &cfg, const std::string &file);
+		/**
+		 * Save configuration to newly created string. Size of the output is estimated
+		 * up front, so the text is written without repeated reallocations.
+		 * @param cfg configuration which will be saved
+		 * @return configuration in ini format
+		 */
+		static std::string save_to_string(const config &cfg);
 		/**
 		 * Save configuration to output stream.
 		 * @param cfg configuration which will be saved
@@ -0,0 +1,101 @@
+#ifndef INICPP_PUSH_PARSER_H
+#define INICPP_PUSH_PARSER_H
+
+#include <memory>
+#include <string>
+
+#include "config.h"
+#include "dll.h"
+#include "exception.h"
+#include "parse_handler.h"
+
+namespace inicpp
+{
+	/** Forward declaration of internal tokenizer */
+	class tokenizer;
+	/** Forward declaration of internal handler which builds config */
+	class config_builder;
+
+	/**
+	 * Resumable parser which accepts ini configuration in chunks of arbitrary size.
+	 * Chunk boundaries can be anywhere, even inside escape sequences, only the
+	 * unfinished last line of a chunk is kept until the next chunk arrives.
+	 * Parsed elements are either collected into config or reported to parse_handler.
+	 */
+	class INICPP_API push_parser
+	{
+	private:
+		/** Builder of resulting config, nullptr if external handler is used */
+		std::unique_ptr<config_builder> builder_;
+		/** Receiver of parsed elements */
+		parse_handler *handler_;
+		/** Tokenizer which holds state of parsing between chunks */
+		std::unique_ptr<tokenizer> tokenizer_;
+		/** Beginning of unfinished line from previous chunks */
+		std::string pending_;
+		/** True if handler requested stop of parsing */
+		bool stopped_;
+
+		/**
+		 * Prepare parser for new input.
+		 */
+		void reset();
+
+	public:
+		/**
+		 * Construct parser which builds config returned by finish().
+		 */
+		push_parser();
+		/**
+		 * Construct parser which reports parsed elements to given handler.
+		 * @param handler receiver of parsed elements, has to outlive the parser
+		 */
+		explicit push_parser(parse_handler &handler);
+		/**
+		 * Deleted copy constructor.
+		 */
+		push_parser(const push_parser &source) = delete;
+		/**
+		 * Deleted copy assignment.
+		 */
+		push_parser &operator=(const push_parser &source) = delete;
+		/**
+		 * Move constructor.
+		 */
+		push_parser(push_parser &&source);
+		/**
+		 * Move assignment.
+		 */
+		push_parser &operator=(push_parser &&source);
+		/**
+		 * Destructor.
+		 */
+		~push_parser();
+
+		/**
+		 * Parse next chunk of ini configuration. All complete lines are processed
+		 * directly from given buffer, which does not need to live after the call.
+		 * @param data next part of input
+		 * @param length size of @a data
+		 * @return false if parsing was stopped by the handler
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		bool feed(const char *data, size_t length);
+		/**
+		 * Parse next chunk of ini configuration.
+		 * @param data next part of input
+		 * @return false if parsing was stopped by the handler
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		bool feed(std::string_view data);
+		/**
+		 * Process the last unfinished line and end the input. Parser is reset
+		 * afterwards, so it can be used for another input.
+		 * @return parsed config, empty if parser reports to external handler
+		 * @throws parser_exception if ini configuration is wrong
+		 */
+		config finish();
+	};
+} // namespace inicpp
+
+#endif // INICPP_PUSH_PARSER_H
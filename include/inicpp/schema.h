@@ -7,6 +7,7 @@
 #include "config.h"
 #include "dll.h"
 #include "exception.h"
+#include "name_index.h"
 #include "option_schema.h"
 #include "section_schema.h"
 
@@ -25,13 +26,12 @@ namespace inicpp
 	{
 	private:
 		using sect_schema_vector = std::vector<std::shared_ptr<section_schema>>;
-		using sect_schema_map = std::map<std::string, std::shared_ptr<section_schema>>;
-		using sect_schema_map_pair = std::pair<std::string, std::shared_ptr<section_schema>>;
+		using sect_schema_index = name_index<section_schema>;
 
 		/** Container for section_schema objects */
 		sect_schema_vector sections_;
-		/** Map of section_schema object for better searching by name */
-		sect_schema_map sections_map_;
+		/** Positions of section_schema objects in the container for better searching by name */
+		sect_schema_index sections_index_;
 
 	public:
 		/**
@@ -76,7 +76,7 @@ namespace inicpp
 		 * @throws not_found_exception if section_name does not exist
 		 * @throws ambiguity_exception if option_schema with given name exists
 		 */
-		void add_option(const std::string &section_name, const option_schema &opt_schema);
+		void add_option(std::string_view section_name, const option_schema &opt_schema);
 		/**
 		 * Creates option_schema from given arguments
 		 * and adds it to specified section.
@@ -86,14 +86,14 @@ namespace inicpp
 		 * @throws ambiguity_exception if option_schema with given name exists
 		 */
 		template <typename ArgType>
-		void add_option(const std::string &section_name, option_schema_params<ArgType> &arguments)
+		void add_option(std::string_view section_name, option_schema_params<ArgType> &arguments)
 		{
-			auto sect_it = sections_map_.find(section_name);
-			if (sect_it != sections_map_.end()) {
+			size_t sect_pos = sections_index_.find(section_name, sections_);
+			if (sect_pos != sect_schema_index::npos) {
 				option_schema opt_schema(arguments);
-				sect_it->second->add_option(opt_schema);
+				sections_[sect_pos]->add_option(opt_schema);
 			} else {
-				throw not_found_exception(section_name);
+				throw not_found_exception(std::string(section_name));
 			}
 		}
 
@@ -122,20 +122,20 @@ namespace inicpp
 		 * @return modifiable reference to stored section_schema
 		 * @throws not_found_exception if section_schema with given name does not exist
 		 */
-		section_schema &operator[](const std::string &section_name);
+		section_schema &operator[](std::string_view section_name);
 		/**
 		 * Access constant reference on section_schema with specified name.
 		 * @param section_name name of requested section_schema
 		 * @return constant reference to stored section_schema
 		 * @throws not_found_exception if section_schema with given name does not exist
 		 */
-		const section_schema &operator[](const std::string &section_name) const;
+		const section_schema &operator[](std::string_view section_name) const;
 		/**
 		 * Tries to find section_schema with specified name inside this config.
 		 * @param section_name name which is searched
 		 * @return true if section_schema with this name is present, false otherwise
 		 */
-		bool contains(const std::string &section_name) const;
+		bool contains(std::string_view section_name) const;
 
 		/**
 		 * Validate cfg against this schema in specified mode.
@@ -4,11 +4,12 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
-#include <map>
+#include <memory_resource>
 #include <vector>
 
 #include "dll.h"
 #include "exception.h"
+#include "name_index.h"
 #include "option.h"
 #include "section_schema.h"
 
@@ -16,6 +17,8 @@ namespace inicpp
 {
 	/** Forward declaration, stated because of ring dependencies */
 	class section_schema;
+	/** Forward declaration, config resolves key handles using section internals */
+	class config;
 	/** Forward declaration of iterator used in section class */
 	template <typename Element> class section_iterator;
 
@@ -23,23 +26,35 @@ namespace inicpp
 	/**
 	 * Represents section from ini format. Can contain multiple options.
 	 * Always should be in config container class.
+	 * Options and their list are allocated from memory resource of the section.
 	 */
 	class INICPP_API section
 	{
 	private:
-		using options_vector = std::vector<std::shared_ptr<option>>;
-		using options_map = std::map<std::string, std::shared_ptr<option>>;
-		using options_map_pair = std::pair<std::string, std::shared_ptr<option>>;
+		using options_vector = std::pmr::vector<std::shared_ptr<option>>;
+		using options_index = name_index<option>;
 
 		/** List of options in this instance */
 		options_vector options_;
-		/** Map of options for better searching */
-		options_map options_map_;
-		/** Name of this section */
+		/** Positions of options in the list for better searching */
+		options_index options_index_;
+		/** Name of this section, empty if it is interned */
 		std::string name_;
+		/** Name interned in symbol table, nullptr if name_ is used */
+		const std::string *symbol_;
+		/** True if section is stored in config, assignment keeps its name then */
+		bool indexed_ = false;
+
+		/** Allocator which places options into memory resource of this section */
+		std::pmr::polymorphic_allocator<option> option_allocator() const
+		{
+			return options_.get_allocator();
+		}
 
 		friend class section_iterator<option>;
 		friend class section_iterator<const option>;
+		friend class config;
+		template <typename Element> friend class name_index;
 
 	public:
 		/** type of iterator */
@@ -52,19 +67,33 @@ namespace inicpp
 		 */
 		section() = delete;
 		/**
-		 * Copy constructor.
+		 * Copy constructor, copy allocates from default memory resource.
 		 */
 		section(const section &source);
 		/**
-		 * Copy assignment.
+		 * Copy constructor which allocates the copy from given memory resource.
+		 * @param source copied section
+		 * @param resource memory resource which has to outlive the section
+		 */
+		section(const section &source, std::pmr::memory_resource *resource);
+		/**
+		 * Copy assignment. Section stored in config keeps its name, which it is found by.
 		 */
 		section &operator=(const section &source);
 		/**
-		 * Move constructor.
+		 * Move constructor, section keeps memory resource of the source.
 		 */
 		section(section &&source);
 		/**
-		 * Move assignment.
+		 * Move constructor which places options into given memory resource.
+		 * Options are moved one by one if resource differs from the one of the source.
+		 * @param source moved section
+		 * @param resource memory resource which has to outlive the section
+		 */
+		section(section &&source, std::pmr::memory_resource *resource);
+		/**
+		 * Move assignment, section keeps its memory resource.
+		 * Section stored in config keeps its name, which it is found by.
 		 */
 		section &operator=(section &&source);
 
@@ -72,7 +101,20 @@ namespace inicpp
 		 * Construct instance of section class with given name.
 		 * @param name name of newly created section class
 		 */
-		section(const std::string &name);
+		section(std::string name);
+		/**
+		 * Construct instance of section class with given name, which allocates
+		 * its options from given memory resource.
+		 * @param name name of newly created section class
+		 * @param resource memory resource which has to outlive the section
+		 */
+		section(std::string name, std::pmr::memory_resource *resource);
+
+		/**
+		 * Getter for memory resource, which options of this section are allocated from.
+		 * @return pointer to memory resource
+		 */
+		std::pmr::memory_resource *get_memory_resource() const;
 
 		/**
 		 * Getter for name of this section.
@@ -80,6 +122,13 @@ namespace inicpp
 		 */
 		const std::string &get_name() const;
 
+		/**
+		 * Share names and single long string values of this section and all its options
+		 * with other sections through given symbol table.
+		 * @param symbols table which has to outlive this section and all its copies
+		 */
+		void intern(symbol_table &symbols);
+
 		/**
 		 * Creates and add option to this section.
 		 * @param option_name name of newly created option class
@@ -88,12 +137,11 @@ namespace inicpp
 		 */
 		template <typename ValueType> void add_option(const std::string &option_name, ValueType value)
 		{
-			auto add_it = options_map_.find(option_name);
-			if (add_it == options_map_.end()) {
-				std::shared_ptr<option> opt = std::make_shared<option>(option_name);
-				opt->set<ValueType>(value);
+			if (options_index_.find(option_name, options_) == options_index::npos) {
+				std::shared_ptr<option> opt = std::allocate_shared<option>(option_allocator(), option_name);
+				opt->set<ValueType>(std::move(value));
 				options_.push_back(opt);
-				options_map_.insert(options_map_pair(opt->get_name(), opt));
+				options_index_.push_back(options_);
 			} else {
 				throw ambiguity_exception(option_name);
 			}
@@ -104,12 +152,34 @@ namespace inicpp
 		 * @throws ambiguity_exception if option with specified name exists
 		 */
 		void add_option(const option &opt);
+		/**
+		 * Add given option instance to options container, option is moved into the section.
+		 * @param opt particular instance of option class
+		 * @throws ambiguity_exception if option with specified name exists
+		 */
+		void add_option(option &&opt);
+		/**
+		 * Construct option in place from given arguments and add it to options container.
+		 * @param args arguments of option constructor, the first one is option name
+		 * @return modifiable reference to newly created option
+		 * @throws ambiguity_exception if option with the same name exists
+		 */
+		template <typename... Args> option &emplace_option(Args &&...args)
+		{
+			std::shared_ptr<option> opt = std::allocate_shared<option>(option_allocator(), std::forward<Args>(args)...);
+			if (options_index_.find(opt->get_name(), options_) != options_index::npos) {
+				throw ambiguity_exception(opt->get_name());
+			}
+			options_.push_back(std::move(opt));
+			options_index_.push_back(options_);
+			return *options_.back();
+		}
 		/**
 		 * From list of options remove the one with specified name
 		 * @param option_name name of option which will be removed
 		 * @throws not_found_exception if option with given name was not found
 		 */
-		void remove_option(const std::string &option_name);
+		void remove_option(std::string_view option_name);
 
 		/**
 		 * Returns size of options list
@@ -136,20 +206,57 @@ namespace inicpp
 		 * @return modifiable reference to stored option
 		 * @throws not_found_exception if option with given name does not exist
 		 */
-		option &operator[](const std::string &option_name);
+		option &operator[](std::string_view option_name);
 		/**
 		 * Access constant reference on option with specified name
 		 * @param option_name
 		 * @return constant reference to stored option
 		 * @throws not_found_exception if option with given name does not exist
 		 */
-		const option &operator[](const std::string &option_name) const;
+		const option &operator[](std::string_view option_name) const;
 		/**
 		 * Tries to find option with specified name inside this section.
 		 * @param option_name name which is searched
 		 * @return true if option with this name is present, false otherwise
 		 */
-		bool contains(const std::string &option_name) const;
+		bool contains(std::string_view option_name) const;
+		/**
+		 * Find option with specified name without throwing if it does not exist.
+		 * @param option_name name which is searched
+		 * @return pointer to stored option, nullptr if option is not present
+		 */
+		option *find(std::string_view option_name);
+		/**
+		 * Find option with specified name without throwing if it does not exist.
+		 * @param option_name name which is searched
+		 * @return pointer to stored option, nullptr if option is not present
+		 */
+		const option *find(std::string_view option_name) const;
+		/**
+		 * Get single value of option with specified name.
+		 * Does not throw if option is missing or its value cannot be converted.
+		 * @param option_name name of requested option
+		 * @return converted value, or empty optional if it is not available
+		 */
+		template <typename ReturnType> std::optional<ReturnType> try_get(std::string_view option_name) const
+		{
+			const option *opt = find(option_name);
+			if (opt == nullptr) { return std::nullopt; }
+			return opt->try_get<ReturnType>();
+		}
+		/**
+		 * Get single value of option with specified name, or given default.
+		 * Does not throw if option is missing or its value cannot be converted.
+		 * @param option_name name of requested option
+		 * @param default_value returned if value is not available
+		 * @return converted value or @a default_value
+		 */
+		template <typename ReturnType> ReturnType get_or(std::string_view option_name, ReturnType default_value) const
+		{
+			const option *opt = find(option_name);
+			if (opt == nullptr) { return default_value; }
+			return opt->get_or<ReturnType>(std::move(default_value));
+		}
 
 		/**
 		 * Validates this section agains given section_schema.
@@ -6,6 +6,7 @@
 
 #include "dll.h"
 #include "exception.h"
+#include "name_index.h"
 #include "option_schema.h"
 #include "section.h"
 #include "types.h"
@@ -38,8 +39,7 @@ namespace inicpp
 	{
 	private:
 		using opt_schema_vector = std::vector<std::shared_ptr<option_schema>>;
-		using opt_schema_map = std::map<std::string, std::shared_ptr<option_schema>>;
-		using opt_schema_map_pair = std::pair<std::string, std::shared_ptr<option_schema>>;
+		using opt_schema_index = name_index<option_schema>;
 
 		/** Section name */
 		std::string name_;
@@ -50,8 +50,12 @@ namespace inicpp
 
 		/** Options stored in this section */
 		opt_schema_vector options_;
-		/** Options stored in map for better searching */
-		opt_schema_map options_map_;
+		/** Positions of options in the list for better searching */
+		opt_schema_index options_index_;
+		/** True if section schema is stored in schema, assignment keeps its name then */
+		bool indexed_ = false;
+
+		template <typename Element> friend class name_index;
 
 	public:
 		/**
@@ -110,11 +114,10 @@ namespace inicpp
 		 */
 		template <typename ArgType> void add_option(const option_schema_params<ArgType> &arguments)
 		{
-			auto add_it = options_map_.find(arguments.name);
-			if (add_it == options_map_.end()) {
+			if (options_index_.find(arguments.name, options_) == opt_schema_index::npos) {
 				std::shared_ptr<option_schema> add = std::make_shared<option_schema>(arguments);
 				options_.push_back(add);
-				options_map_.insert(opt_schema_map_pair(add->get_name(), add));
+				options_index_.push_back(options_);
 			} else {
 				throw ambiguity_exception(arguments.name);
 			}
@@ -124,7 +127,7 @@ namespace inicpp
 		 * @param name name of option schema to be removed
 		 * @throws not_found_exception if given option does not exist
 		 */
-		void remove_option(const std::string &name);
+		void remove_option(std::string_view name);
 
 		/**
 		 * Returns size of option schemas list
@@ -151,20 +154,20 @@ namespace inicpp
 		 * @return modifiable reference to stored option_schema
 		 * @throws not_found_exception if option_schema with given name does not exist
 		 */
-		option_schema &operator[](const std::string &option_name);
+		option_schema &operator[](std::string_view option_name);
 		/**
 		 * Access constant reference on option_schema with specified name
 		 * @param option_name
 		 * @return constant reference to stored option_schema
 		 * @throws not_found_exception if option_schema with given name does not exist
 		 */
-		const option_schema &operator[](const std::string &option_name) const;
+		const option_schema &operator[](std::string_view option_name) const;
 		/**
 		 * Tries to find option_schema with specified name inside this section.
 		 * @param option_name name which is searched
 		 * @return true if option_schema with this name is present, false otherwise
 		 */
-		bool contains(const std::string &option_name) const;
+		bool contains(std::string_view option_name) const;
 
 		/**
 		 * Validate given section againts this section_schema.
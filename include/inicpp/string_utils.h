@@ -8,6 +8,7 @@
 #include <cctype>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace inicpp
@@ -24,18 +25,54 @@ namespace inicpp
 		 * @return newly created instance of string
 		 */
 		INICPP_API std::string left_trim(const std::string &str);
+		/**
+		 * Trim whitespaces from start of given C string.
+		 * @param str processed string
+		 * @return newly created instance of string
+		 */
+		INICPP_API std::string left_trim(const char *str);
+		/**
+		 * Trim whitespaces from start of given string view. No allocation is done.
+		 * @param str processed string
+		 * @return view into the given string
+		 */
+		INICPP_API std::string_view left_trim(std::string_view str);
 		/**
 		 * Trim whitespaces from end of given string.
 		 * @param str processed string
 		 * @return newly created instance of string
 		 */
 		INICPP_API std::string right_trim(const std::string &str);
+		/**
+		 * Trim whitespaces from end of given C string.
+		 * @param str processed string
+		 * @return newly created instance of string
+		 */
+		INICPP_API std::string right_trim(const char *str);
+		/**
+		 * Trim whitespaces from end of given string view. No allocation is done.
+		 * @param str processed string
+		 * @return view into the given string
+		 */
+		INICPP_API std::string_view right_trim(std::string_view str);
 		/**
 		 * Trim whitespaces from start and end of given string.
 		 * @param str processed string
 		 * @return newly created instance of string
 		 */
 		INICPP_API std::string trim(const std::string &str);
+		/**
+		 * Trim whitespaces from start and end of given C string.
+		 * @param str processed string
+		 * @return newly created instance of string
+		 */
+		INICPP_API std::string trim(const char *str);
+		/**
+		 * Trim whitespaces from start and end of given string view. No allocation is done.
+		 * @param str processed string
+		 * @return view into the given string
+		 */
+		INICPP_API std::string_view trim(std::string_view str);
 		/**
 		 * In @a haystack find any occurence of needle.
 		 * @param haystack string in which search is executed
@@ -45,18 +82,28 @@ namespace inicpp
 		INICPP_API bool find_needle(const std::string &haystack, const std::string &needle);
 		/**
 		 * Tries to find out if given @a str starts with @a search_str.
+		 * Accepts std::string, string literals and views alike.
 		 * @param str searched string
 		 * @param search_str string which is searched for
 		 * @return true if given string starts with @a search_str
 		 */
-		INICPP_API bool starts_with(const std::string &str, const std::string &search_str);
+		INICPP_API bool starts_with(std::string_view str, std::string_view search_str);
 		/**
 		 * Tries to find out if given @a str ends with @a search_str.
+		 * Accepts std::string, string literals and views alike.
 		 * @param str searched string
 		 * @param search_str string which is searched for
 		 * @return true if given string starts with @a search_str
 		 */
-		INICPP_API bool ends_with(const std::string &str, const std::string &search_str);
+		INICPP_API bool ends_with(std::string_view str, std::string_view search_str);
+		/**
+		 * Determines whether given string is valid name of section or option.
+		 * Identifier has to match regular expression "^[a-zA-Z.$:][-a-zA-Z0-9_~.:$ ]*$",
+		 * check is done through precomputed table of character classes.
+		 * @param str checked string
+		 * @return true if identifier is valid, false otherwise
+		 */
+		INICPP_API bool is_valid_identifier(std::string_view str);
 		/**
 		 * Split given string with given delimiter.
 		 * @param str text which will be splitted
@@ -64,6 +111,20 @@ namespace inicpp
 		 * @return array of newly created substrings
 		 */
 		INICPP_API std::vector<std::string> split(const std::string &str, char delim);
+		/**
+		 * Append given string to the result, leading and trailing whitespace is escaped,
+		 * so that the string is read back the same from ini file.
+		 * @param result string to which escaped text is appended
+		 * @param str appended text
+		 */
+		INICPP_API void append_escaped(std::string &result, std::string_view str);
+		/**
+		 * Append textual form of given value to the result, the same as it is written to ini file.
+		 * Floating point numbers are written in the shortest form which is read back to the same value.
+		 * @param result string to which the value is appended
+		 * @param value appended value
+		 */
+		INICPP_API void append_value(std::string &result, const option_value &value);
 
 
 		/**
@@ -74,15 +135,14 @@ namespace inicpp
 		 * @throws invalid_type_exception if such cast cannot be made
 		 */
 		template <typename ReturnType>
-		ReturnType parse_string(
-			[[maybe_unused]] const std::string &value, [[maybe_unused]] const std::string &option_name)
+		ReturnType parse_string([[maybe_unused]] std::string_view value, [[maybe_unused]] std::string_view option_name)
 		{
 			throw invalid_type_exception("Invalid option type");
 		}
 		/**
 		 * Specialization for string type, which doesn't need to be explicitely parsed.
 		 */
-		template <> INICPP_API string_ini_t parse_string<string_ini_t>(const std::string& value, const std::string&);
+		template <> INICPP_API string_ini_t parse_string<string_ini_t>(std::string_view value, std::string_view);
 		/**
 		 * Parse string to boolean value.
 		 * @param value Value to be parsed
@@ -90,7 +150,7 @@ namespace inicpp
 		 * @return parsed value with correct type
 		 * @throws invalid_type_exception if string cannot be parsed
 		 */
-		template <> INICPP_API boolean_ini_t parse_string<boolean_ini_t>(const std::string& value, const std::string& option_name);
+		template <> INICPP_API boolean_ini_t parse_string<boolean_ini_t>(std::string_view value, std::string_view option_name);
 		/**
 		 * Parse string to enum value.
 		 * @param value Value to be parsed
@@ -98,7 +158,7 @@ namespace inicpp
 		 * @return parsed value with correct type
 		 * @throws invalid_type_exception if string cannot be parsed
 		 */
-		template <> INICPP_API enum_ini_t parse_string<enum_ini_t>(const std::string& value, const std::string& option_name);
+		template <> INICPP_API enum_ini_t parse_string<enum_ini_t>(std::string_view value, std::string_view option_name);
 		/**
 		 * Parse string to float value.
 		 * @param value Value to be parsed
@@ -106,7 +166,7 @@ namespace inicpp
 		 * @return parsed value with correct type
 		 * @throws invalid_type_exception if string cannot be parsed
 		 */
-		template <> INICPP_API float_ini_t parse_string<float_ini_t>(const std::string& value, const std::string& option_name);
+		template <> INICPP_API float_ini_t parse_string<float_ini_t>(std::string_view value, std::string_view option_name);
 		/**
 		 * Parse string to signed value.
 		 * @param value Value to be parsed
@@ -114,7 +174,7 @@ namespace inicpp
 		 * @return parsed value with correct type
 		 * @throws invalid_type_exception if string cannot be parsed
 		 */
-		template <> INICPP_API signed_ini_t parse_string<signed_ini_t>(const std::string &value, const std::string &option_name);
+		template <> INICPP_API signed_ini_t parse_string<signed_ini_t>(std::string_view value, std::string_view option_name);
 		/**
 		 * Parse string to unsigned value.
 		 * @param value Value to be parsed
@@ -122,7 +182,44 @@ namespace inicpp
 		 * @return parsed value with correct type
 		 * @throws invalid_type_exception if string cannot be parsed
 		 */
-		template <> INICPP_API unsigned_ini_t parse_string<unsigned_ini_t>(const std::string &value, const std::string &option_name);
+		template <> INICPP_API unsigned_ini_t parse_string<unsigned_ini_t>(std::string_view value, std::string_view option_name);
+
+		/**
+		 * Function for parsing string input value to strongly typed one, which reports
+		 * failure by return value. Accepts exactly the same strings as parse_string().
+		 * @param value Value to be parsed
+		 * @param result Parsed value, unchanged if parsing fails
+		 * @return true if value was parsed
+		 */
+		template <typename ReturnType>
+		bool try_parse_string([[maybe_unused]] std::string_view value, [[maybe_unused]] ReturnType &result)
+		{
+			return false;
+		}
+		/**
+		 * Specialization for string type, which always succeeds.
+		 */
+		template <> INICPP_API bool try_parse_string<string_ini_t>(std::string_view value, string_ini_t &result);
+		/**
+		 * Specialization for boolean type.
+		 */
+		template <> INICPP_API bool try_parse_string<boolean_ini_t>(std::string_view value, boolean_ini_t &result);
+		/**
+		 * Specialization for enum type, which always succeeds.
+		 */
+		template <> INICPP_API bool try_parse_string<enum_ini_t>(std::string_view value, enum_ini_t &result);
+		/**
+		 * Specialization for float type.
+		 */
+		template <> INICPP_API bool try_parse_string<float_ini_t>(std::string_view value, float_ini_t &result);
+		/**
+		 * Specialization for signed type.
+		 */
+		template <> INICPP_API bool try_parse_string<signed_ini_t>(std::string_view value, signed_ini_t &result);
+		/**
+		 * Specialization for unsigned type.
+		 */
+		template <> INICPP_API bool try_parse_string<unsigned_ini_t>(std::string_view value, unsigned_ini_t &result);
 	} // namespace string_utils
 
 	/** Internal namespace to hide to_string methods. */
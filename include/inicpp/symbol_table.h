@@ -0,0 +1,75 @@
+#ifndef INICPP_SYMBOL_TABLE_H
+#define INICPP_SYMBOL_TABLE_H
+
+#include <atomic>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "dll.h"
+
+namespace inicpp
+{
+	/**
+	 * Shared immutable storage of names and values, which can be used by many configs.
+	 * Each distinct string is stored only once and interned strings never move,
+	 * so equal interned strings can be compared by their addresses.
+	 * Table has to outlive all configs which were interned into it.
+	 * All member functions can be called concurrently, e.g. from parallel loads.
+	 */
+	class INICPP_API symbol_table
+	{
+	private:
+		/** Interned strings, deque never moves already stored ones */
+		std::deque<std::string> symbols_;
+		/** Interned strings by their text */
+		std::unordered_map<std::string_view, const std::string *> index_;
+		/** Guards symbols_ and index_, lookups share it */
+		mutable std::shared_mutex mutex_;
+		/** Bytes of copies which were not allocated thanks to interning */
+		std::atomic<size_t> bytes_saved_;
+
+		/**
+		 * Count bytes which would be allocated by own copy of given string.
+		 */
+		void count_saved(std::string_view text);
+
+	public:
+		/**
+		 * Construct empty table.
+		 */
+		symbol_table();
+		/**
+		 * Copy constructor is deleted, interned strings are referenced by their address.
+		 */
+		symbol_table(const symbol_table &source) = delete;
+		/**
+		 * Copy assignment is deleted, interned strings are referenced by their address.
+		 */
+		symbol_table &operator=(const symbol_table &source) = delete;
+
+		/**
+		 * Get shared copy of given string, which is stored if it was not interned yet.
+		 * @param text interned string
+		 * @return reference to stored string valid for whole life of the table
+		 */
+		const std::string &intern(std::string_view text);
+
+		/**
+		 * Number of distinct interned strings.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Memory saved by interning: sum of sizes of heap buffers, which would be allocated
+		 * by own copies of strings found in the table. Short strings which fit into
+		 * std::string itself are not counted.
+		 * @return number of bytes
+		 */
+		size_t bytes_saved() const;
+	};
+} // namespace inicpp
+
+#endif // INICPP_SYMBOL_TABLE_H
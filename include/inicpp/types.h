@@ -24,6 +24,10 @@ namespace inicpp
 		internal_enum_type(const std::string &value) : data_(value)
 		{
 		}
+		/** Constructor with initial value, which is moved */
+		internal_enum_type(std::string &&value) noexcept : data_(std::move(value))
+		{
+		}
 		/** Constructor with initial value */
 		internal_enum_type(const char *value) : data_(value)
 		{
@@ -33,6 +37,10 @@ namespace inicpp
 		{
 			this->operator=(other);
 		}
+		/** Move constructor */
+		internal_enum_type(internal_enum_type &&other) noexcept : data_(std::move(other.data_))
+		{
+		}
 		/** Conversion contructor - only for template compilation, allways throws std::runtime_error */
 		[[noreturn]] explicit internal_enum_type(bool) : data_()
 		{
@@ -60,6 +68,12 @@ namespace inicpp
 			data_ = other.data_;
 			return *this;
 		}
+		/** Move assignment operator */
+		internal_enum_type &operator=(internal_enum_type &&other) noexcept
+		{
+			data_ = std::move(other.data_);
+			return *this;
+		}
 		/** Conversion operator to std::string type */
 		operator std::string() const
 		{
@@ -0,0 +1,350 @@
+#ifndef INICPP_VALUE_LIST_H
+#define INICPP_VALUE_LIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "dll.h"
+#include "types.h"
+
+namespace inicpp
+{
+	/** Forward declaration of storage of shared strings */
+	class symbol_table;
+
+	/**
+	 * Homogeneous list of option values in compact 16 byte representation.
+	 * Single number or boolean is stored inline, as well as single short string.
+	 * Only lists and long strings spill to heap, where all values of the list are stored
+	 * in one contiguous array of their type (booleans are packed into bits).
+	 * Single long string can be also shared with other lists through symbol table.
+	 * Type of empty list is not significant, values of any type can be added to it.
+	 */
+	class INICPP_API value_list
+	{
+	private:
+		using arrays = std::variant<std::vector<boolean_ini_t>,
+			std::vector<signed_ini_t>,
+			std::vector<unsigned_ini_t>,
+			std::vector<float_ini_t>,
+			std::vector<enum_ini_t>,
+			std::vector<string_ini_t>>;
+
+		/** How values are stored */
+		enum class layout : uint8_t {
+			/** There are no values */
+			empty,
+			/** One number or boolean stored inline */
+			scalar,
+			/** One short string or enum stored inline, length_ holds its length */
+			small,
+			/** One string or enum interned in symbol table, storage holds pointer to it */
+			shared,
+			/** Array of any length allocated on heap */
+			heap
+		};
+
+		/** Maximal length of string which is stored inline */
+		static constexpr size_t small_capacity = 13;
+
+		/** Inline value, characters of inline string or pointer to heap array */
+		alignas(8) char storage_[small_capacity];
+		/** Length of inline string */
+		uint8_t length_;
+		/** How values are stored */
+		layout layout_;
+		/** Index of type of the values in option_value */
+		uint8_t type_;
+
+		/** Index of given type in option_value, which is also index of its array in arrays */
+		template <typename ValueType, size_t Index = 0> static constexpr uint8_t type_id()
+		{
+			if constexpr (std::is_same_v<std::variant_alternative_t<Index, option_value>, ValueType>) {
+				return static_cast<uint8_t>(Index);
+			} else {
+				return type_id<ValueType, Index + 1>();
+			}
+		}
+		/** Determines whether values of given type are stored as inline characters */
+		template <typename ValueType> static constexpr bool is_textual()
+		{
+			return std::is_same_v<ValueType, string_ini_t> || std::is_same_v<ValueType, enum_ini_t>;
+		}
+
+		/** Inline value of given type */
+		template <typename ValueType> const ValueType *inline_value() const
+		{
+			return std::launder(reinterpret_cast<const ValueType *>(storage_));
+		}
+		/** String interned in symbol table */
+		const std::string &symbol() const
+		{
+			return **std::launder(reinterpret_cast<const std::string *const *>(storage_));
+		}
+		/** Array allocated on heap */
+		arrays *heap() const
+		{
+			return *std::launder(reinterpret_cast<arrays *const *>(storage_));
+		}
+		/** Take ownership of given heap array */
+		void set_heap(arrays *array)
+		{
+			new (storage_) arrays *(array);
+			layout_ = layout::heap;
+		}
+		/** Free heap array if there is any, list becomes empty */
+		void release();
+		/** Copy values of given list into this empty list */
+		void copy_from(const value_list &source);
+		/** Take values of given list into this empty list, source becomes empty */
+		void move_from(value_list &source) noexcept;
+
+		/**
+		 * Store single value, list has to be empty.
+		 */
+		template <typename ValueType> void set_single(ValueType value)
+		{
+			type_ = type_id<ValueType>();
+			if constexpr (is_textual<ValueType>()) {
+				std::string text = std::move(value);
+				if (text.size() <= small_capacity) {
+					std::memcpy(storage_, text.data(), text.size());
+					length_ = static_cast<uint8_t>(text.size());
+					layout_ = layout::small;
+				} else {
+					set_heap(new arrays(std::in_place_type<std::vector<ValueType>>, 1, ValueType(std::move(text))));
+				}
+			} else {
+				new (storage_) ValueType(value);
+				layout_ = layout::scalar;
+			}
+		}
+		/**
+		 * Get array of given type on heap, inline value is moved to it.
+		 * List has to be empty or hold given type.
+		 */
+		template <typename ValueType> std::vector<ValueType> &prepare_array()
+		{
+			if (layout_ == layout::heap) {
+				arrays &array = *heap();
+				if (auto typed = std::get_if<std::vector<ValueType>>(&array)) { return *typed; }
+				type_ = type_id<ValueType>();
+				return array.template emplace<std::vector<ValueType>>();
+			}
+
+			std::vector<ValueType> values;
+			if (layout_ != layout::empty) { values.push_back(get<ValueType>(0)); }
+			type_ = type_id<ValueType>();
+			set_heap(new arrays(std::in_place_type<std::vector<ValueType>>, std::move(values)));
+			return std::get<std::vector<ValueType>>(*heap());
+		}
+
+	public:
+		/**
+		 * Construct empty list.
+		 */
+		value_list() : storage_(), length_(0), layout_(layout::empty), type_(type_id<string_ini_t>())
+		{
+		}
+		/**
+		 * Construct list which takes given values, single value is stored inline if possible.
+		 * @param values stored values
+		 */
+		template <typename ValueType> explicit value_list(std::vector<ValueType> values) : value_list()
+		{
+			type_ = type_id<ValueType>();
+			bool spilled = false;
+			if constexpr (std::is_same_v<ValueType, string_ini_t>) {
+				// long string keeps its array, which is moved to heap without copying
+				spilled = (values.size() == 1 && values.front().size() > small_capacity);
+			}
+			if (values.size() == 1 && !spilled) {
+				set_single<ValueType>(std::move(values.front()));
+			} else if (!values.empty()) {
+				set_heap(new arrays(std::in_place_type<std::vector<ValueType>>, std::move(values)));
+			}
+		}
+		/**
+		 * Copy constructor.
+		 */
+		value_list(const value_list &source);
+		/**
+		 * Copy assignment.
+		 */
+		value_list &operator=(const value_list &source);
+		/**
+		 * Move constructor.
+		 */
+		value_list(value_list &&source) noexcept;
+		/**
+		 * Move assignment.
+		 */
+		value_list &operator=(value_list &&source) noexcept;
+		/**
+		 * Destructor.
+		 */
+		~value_list();
+
+		/**
+		 * Number of stored values.
+		 * @return unsigned integer
+		 */
+		size_t size() const;
+		/**
+		 * Determines whether list contains no values.
+		 * @return true if list is empty
+		 */
+		bool empty() const
+		{
+			return size() == 0;
+		}
+		/**
+		 * Determines whether values are stored as given type, regardless of emptiness.
+		 * @return true if values have given type
+		 */
+		template <typename ValueType> bool holds() const
+		{
+			return type_ == type_id<ValueType>();
+		}
+		/**
+		 * Copy value on specified position, list has to hold given type.
+		 * @param index position of the value, has to be lesser than size()
+		 * @return copy of the value
+		 */
+		template <typename ValueType> ValueType get(size_t index) const
+		{
+			if constexpr (is_textual<ValueType>()) {
+				if (layout_ == layout::small) { return ValueType(std::string(storage_, length_)); }
+				if (layout_ == layout::shared) { return ValueType(symbol()); }
+			} else {
+				if (layout_ == layout::scalar) { return *inline_value<ValueType>(); }
+			}
+			return std::get<std::vector<ValueType>>(*heap())[index];
+		}
+		/**
+		 * Access string on specified position without copying, list has to hold strings.
+		 * @param index position of the value, has to be lesser than size()
+		 * @return view of the string valid until the list is modified
+		 * @throws not_found_exception if the list is empty
+		 */
+		std::string_view string_at(size_t index) const;
+		/**
+		 * Access contiguous array of values of given type, which cannot be boolean.
+		 * @return pointer to the first value, nullptr if list is empty,
+		 *   holds different type or values are single inline string or shared enum
+		 */
+		template <typename ValueType> const ValueType *data() const
+		{
+			static_assert(!std::is_same_v<ValueType, boolean_ini_t>, "booleans are packed into bits");
+			if (!holds<ValueType>()) { return nullptr; }
+			if constexpr (std::is_same_v<ValueType, string_ini_t>) {
+				if (layout_ == layout::shared) { return &symbol(); }
+			} else if constexpr (!is_textual<ValueType>()) {
+				if (layout_ == layout::scalar) { return inline_value<ValueType>(); }
+			}
+			return (layout_ == layout::heap ? std::get<std::vector<ValueType>>(*heap()).data() : nullptr);
+		}
+		/**
+		 * Access array of values of given type allocated on heap.
+		 * @return pointer to the array, nullptr if values are stored inline or have different type
+		 */
+		template <typename ValueType> const std::vector<ValueType> *array() const
+		{
+			return (layout_ == layout::heap ? std::get_if<std::vector<ValueType>>(heap()) : nullptr);
+		}
+		/**
+		 * Copy all values into new array, list has to hold given type.
+		 * @return newly created array
+		 */
+		template <typename ValueType> std::vector<ValueType> to_vector() const
+		{
+			if (auto values = array<ValueType>()) { return *values; }
+			if (layout_ == layout::empty) { return {}; }
+			return std::vector<ValueType>(1, get<ValueType>(0));
+		}
+		/**
+		 * Copy value on specified position into variant.
+		 * @param index position of the value, has to be lesser than size()
+		 * @return copy of the value
+		 */
+		option_value operator[](size_t index) const;
+
+		/**
+		 * Append value, type of the list is changed if it is empty.
+		 * @param value appended value of the same type as other values
+		 */
+		template <typename ValueType> void push_back(ValueType value)
+		{
+			if (empty()) {
+				release();
+				set_single<ValueType>(std::move(value));
+			} else {
+				prepare_array<ValueType>().push_back(std::move(value));
+			}
+		}
+		/**
+		 * Insert value on specified position, type of the list is changed if it is empty.
+		 * @param value inserted value of the same type as other values
+		 * @param index position of the value, has to be at most size()
+		 */
+		template <typename ValueType> void insert(ValueType value, size_t index)
+		{
+			if (empty()) {
+				push_back<ValueType>(std::move(value));
+			} else {
+				std::vector<ValueType> &values = prepare_array<ValueType>();
+				values.insert(std::next(values.begin(), static_cast<std::ptrdiff_t>(index)), std::move(value));
+			}
+		}
+		/**
+		 * Remove the first value equal to given one, nothing is removed if list holds different type.
+		 * @param value removed value
+		 */
+		template <typename ValueType> void remove(const ValueType &value)
+		{
+			if (!holds<ValueType>()) {
+				return;
+			} else if (layout_ == layout::heap) {
+				auto &values = std::get<std::vector<ValueType>>(*heap());
+				auto it = std::find(values.begin(), values.end(), value);
+				if (it != values.end()) { values.erase(it); }
+			} else if (layout_ != layout::empty && get<ValueType>(0) == value) {
+				release();
+			}
+		}
+		/**
+		 * Remove value on specified position.
+		 * @param index position of the value, has to be lesser than size()
+		 */
+		void erase(size_t index);
+		/**
+		 * Remove all values, type of the list is kept.
+		 */
+		void clear();
+
+		/**
+		 * Share single long string or enum with other lists through given symbol table.
+		 * Other lists are not changed.
+		 * @param symbols table which has to outlive this list and all its copies
+		 */
+		void intern(symbol_table &symbols);
+
+		/**
+		 * Equality operator, lists are equal if they have the same type and values,
+		 * or if both are empty.
+		 */
+		bool operator==(const value_list &other) const;
+		/**
+		 * Inequality operator.
+		 */
+		bool operator!=(const value_list &other) const;
+	};
+} // namespace inicpp
+
+#endif // INICPP_VALUE_LIST_H
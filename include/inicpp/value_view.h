@@ -0,0 +1,258 @@
+#ifndef INICPP_VALUE_VIEW_H
+#define INICPP_VALUE_VIEW_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "exception.h"
+#include "types.h"
+
+namespace inicpp
+{
+	/**
+	 * Non-owning view of contiguous array of option values.
+	 * Values are accessed in place, so iteration does not allocate or convert anything.
+	 * Single short string is stored in the option as characters only, the view holds
+	 * its own copy then, which fits into small string buffer and is not allocated.
+	 * View is valid until the option it was taken from is modified or destroyed.
+	 */
+	template <typename ValueType> class value_view
+	{
+	private:
+		/** The first viewed value */
+		const ValueType *first_;
+		/** Number of viewed values */
+		size_t size_;
+		/** Single value held by the view, viewed if first_ points to it */
+		ValueType single_;
+		/** Values owned by the view, set only if they could not be viewed in the option */
+		std::shared_ptr<const std::vector<ValueType>> owned_;
+
+		/** Copy viewed range of given view, its single value is viewed in the own copy */
+		void view_range_of(const value_view &source)
+		{
+			first_ = (source.first_ == &source.single_ ? &single_ : source.first_);
+			size_ = source.size_;
+		}
+
+	public:
+		/** Random access iterator over viewed values */
+		using iterator = const ValueType *;
+		/** Type returned by element access */
+		using const_reference = const ValueType &;
+
+		/**
+		 * Construct empty view.
+		 */
+		value_view() : first_(nullptr), size_(0), single_(), owned_()
+		{
+		}
+		/**
+		 * Construct view of given array.
+		 * @param first pointer to the first value of array, which has to outlive the view
+		 * @param size number of values in the array
+		 */
+		value_view(const ValueType *first, size_t size) : first_(first), size_(size), single_(), owned_()
+		{
+		}
+		/**
+		 * Construct view of single value held by the view.
+		 * @param value viewed value
+		 */
+		value_view(std::in_place_t, ValueType value) : first_(&single_), size_(1), single_(std::move(value)), owned_()
+		{
+		}
+		/**
+		 * Construct view which owns given values.
+		 * @param values viewed values
+		 */
+		explicit value_view(std::shared_ptr<const std::vector<ValueType>> values)
+			: first_(values->data()), size_(values->size()), single_(), owned_(std::move(values))
+		{
+		}
+		/**
+		 * Copy constructor.
+		 */
+		value_view(const value_view &source) : first_(), size_(), single_(source.single_), owned_(source.owned_)
+		{
+			view_range_of(source);
+		}
+		/**
+		 * Copy assignment.
+		 */
+		value_view &operator=(const value_view &source)
+		{
+			if (&source != this) {
+				single_ = source.single_;
+				owned_ = source.owned_;
+				view_range_of(source);
+			}
+			return *this;
+		}
+
+		/**
+		 * Number of viewed values.
+		 * @return unsigned integer
+		 */
+		size_t size() const
+		{
+			return size_;
+		}
+		/**
+		 * Determines whether view contains no values.
+		 * @return true if there are no values
+		 */
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+		/**
+		 * Access value on specified index without range checking.
+		 * @param index index of requested value, has to be lesser than size()
+		 * @return constant reference to the value
+		 */
+		const_reference operator[](size_t index) const
+		{
+			return first_[index];
+		}
+		/**
+		 * Access value on specified index.
+		 * @param index index of requested value
+		 * @return constant reference to the value
+		 * @throws not_found_exception if index is out of range
+		 */
+		const_reference at(size_t index) const
+		{
+			if (index >= size_) { throw not_found_exception(index); }
+
+			return first_[index];
+		}
+
+		/**
+		 * Iterator pointing at the first value.
+		 * @return iterator
+		 */
+		iterator begin() const
+		{
+			return first_;
+		}
+		/**
+		 * Iterator pointing behind the last value.
+		 * @return iterator
+		 */
+		iterator end() const
+		{
+			return first_ + size_;
+		}
+	};
+
+
+	/**
+	 * Non-owning view of booleans packed into bits.
+	 * Values are accessed in place, elements are returned by value.
+	 * View is valid until the option it was taken from is modified or destroyed.
+	 */
+	template <> class value_view<boolean_ini_t>
+	{
+	private:
+		using values_vector = std::vector<boolean_ini_t>;
+
+		/** Viewed values */
+		const values_vector *values_;
+		/** Values owned by the view, set only if they could not be viewed in the option */
+		std::shared_ptr<const values_vector> owned_;
+
+		/** Shared array without values */
+		static const values_vector &no_values()
+		{
+			static const values_vector values;
+			return values;
+		}
+
+	public:
+		/** Random access iterator over viewed values */
+		using iterator = values_vector::const_iterator;
+		/** Type returned by element access, copy of the value */
+		using const_reference = values_vector::const_reference;
+
+		/**
+		 * Construct empty view.
+		 */
+		value_view() : values_(&no_values()), owned_()
+		{
+		}
+		/**
+		 * Construct view of given values.
+		 * @param values viewed values, which have to outlive the view
+		 */
+		explicit value_view(const values_vector &values) : values_(&values), owned_()
+		{
+		}
+		/**
+		 * Construct view which owns given values.
+		 * @param values viewed values
+		 */
+		explicit value_view(std::shared_ptr<const values_vector> values)
+			: values_(values.get()), owned_(std::move(values))
+		{
+		}
+
+		/**
+		 * Number of viewed values.
+		 * @return unsigned integer
+		 */
+		size_t size() const
+		{
+			return values_->size();
+		}
+		/**
+		 * Determines whether view contains no values.
+		 * @return true if there are no values
+		 */
+		bool empty() const
+		{
+			return values_->empty();
+		}
+		/**
+		 * Access value on specified index without range checking.
+		 * @param index index of requested value, has to be lesser than size()
+		 * @return copy of the value
+		 */
+		const_reference operator[](size_t index) const
+		{
+			return (*values_)[index];
+		}
+		/**
+		 * Access value on specified index.
+		 * @param index index of requested value
+		 * @return copy of the value
+		 * @throws not_found_exception if index is out of range
+		 */
+		const_reference at(size_t index) const
+		{
+			if (index >= values_->size()) { throw not_found_exception(index); }
+
+			return (*values_)[index];
+		}
+
+		/**
+		 * Iterator pointing at the first value.
+		 * @return iterator
+		 */
+		iterator begin() const
+		{
+			return values_->begin();
+		}
+		/**
+		 * Iterator pointing behind the last value.
+		 * @return iterator
+		 */
+		iterator end() const
+		{
+			return values_->end();
+		}
+	};
+} // namespace inicpp
+
+#endif // INICPP_VALUE_VIEW_H
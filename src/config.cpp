@@ -1,53 +1,113 @@
 #include "config.h"
+#include "frozen_config.h"
+#include "serializer.h"
 
 namespace inicpp
 {
-	config::config() : sections_(), sections_map_()
+	config::config() : sections_(), sections_index_()
 	{
 	}
 
-	config::config(const config &source) : sections_(), sections_map_()
+	config::config(std::pmr::memory_resource *resource) : sections_(resource), sections_index_(resource)
 	{
-		// we have to do deep copies of sections
-		sections_.reserve(source.sections_.size());
-		for (auto &sect : source.sections_) { sections_.push_back(std::make_shared<section>(*sect)); }
+	}
+
+	config::config(const config &source) : config(source, std::pmr::get_default_resource())
+	{
+	}
 
-		// we already have constructed sections... now push them into map
-		for (auto &sect : sections_) { sections_map_.insert(sections_map_pair(sect->get_name(), sect)); }
+	config::config(const config &source, std::pmr::memory_resource *resource)
+		: sections_(resource), sections_index_(source.sections_index_, resource)
+	{
+		// we have to do deep copies of sections, index of source is valid for them,
+		//   because they are stored on the same positions
+		sections_.reserve(source.sections_.size());
+		for (auto &sect : source.sections_) {
+			sections_.push_back(std::allocate_shared<section>(section_allocator(), *sect, resource));
+		}
+		sections_index::adopt(sections_);
 	}
 
 	config &config::operator=(const config &source)
 	{
 		if (this != &source) {
-			// make copy of input source config and swap it with this
-			config new_src(source);
-			std::swap(*this, new_src);
+			// make copy of input source config in our resource and move it to this
+			operator=(config(source, get_memory_resource()));
 		}
 
 		return *this;
 	}
 
-	config::config(config &&source) : sections_(), sections_map_()
+	config::config(config &&source)
+		: sections_(std::move(source.sections_)), sections_index_(std::move(source.sections_index_))
+	{
+	}
+
+	config::config(config &&source, std::pmr::memory_resource *resource)
+		: sections_(resource), sections_index_(resource)
 	{
-		operator=(std::move(source));
+		if (*resource == *source.get_memory_resource()) {
+			sections_ = std::move(source.sections_);
+			sections_index_ = std::move(source.sections_index_);
+			return;
+		}
+
+		// sections are placed into our resource, so they are different objects and index gets new generation
+		sections_.reserve(source.sections_.size());
+		for (auto &sect : source.sections_) {
+			sections_.push_back(std::allocate_shared<section>(section_allocator(), std::move(*sect), resource));
+		}
+		sections_index_ = sections_index(source.sections_index_, resource);
+		sections_index::adopt(sections_);
+		source.sections_.clear();
+		source.sections_index_.clear();
 	}
 
 	config &config::operator=(config &&source)
 	{
-		if (this != &source) {
+		if (this == &source) { return *this; }
+
+		if (*get_memory_resource() == *source.get_memory_resource()) {
 			sections_ = std::move(source.sections_);
-			sections_map_ = std::move(source.sections_map_);
+			sections_index_ = std::move(source.sections_index_);
+		} else {
+			// pointers of source cannot be taken, sections are moved into our resource first
+			operator=(config(std::move(source), get_memory_resource()));
 		}
 		return *this;
 	}
 
+	std::pmr::memory_resource *config::get_memory_resource() const
+	{
+		return sections_.get_allocator().resource();
+	}
+
+	frozen_config config::freeze() const
+	{
+		return frozen_config(*this);
+	}
+
+	void config::intern(symbol_table &symbols)
+	{
+		for (auto &sect : sections_) { sect->intern(symbols); }
+	}
+
 	void config::add_section(const section &sect)
 	{
-		auto add_it = sections_map_.find(sect.get_name());
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section> add = std::make_shared<section>(sect);
-			sections_.push_back(add);
-			sections_map_.insert(sections_map_pair(add->get_name(), add));
+		if (sections_index_.find(sect.get_name(), sections_) == sections_index::npos) {
+			sections_.push_back(std::allocate_shared<section>(section_allocator(), sect, get_memory_resource()));
+			sections_index_.push_back(sections_);
+		} else {
+			throw ambiguity_exception(sect.get_name());
+		}
+	}
+
+	void config::add_section(section &&sect)
+	{
+		if (sections_index_.find(sect.get_name(), sections_) == sections_index::npos) {
+			sections_.push_back(
+				std::allocate_shared<section>(section_allocator(), std::move(sect), get_memory_resource()));
+			sections_index_.push_back(sections_);
 		} else {
 			throw ambiguity_exception(sect.get_name());
 		}
@@ -55,50 +115,54 @@ namespace inicpp
 
 	void config::add_section(const std::string &section_name)
 	{
-		auto add_it = sections_map_.find(section_name);
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section> add = std::make_shared<section>(section_name);
-			sections_.push_back(add);
-			sections_map_.insert(sections_map_pair(add->get_name(), add));
+		if (sections_index_.find(section_name, sections_) == sections_index::npos) {
+			sections_.push_back(
+				std::allocate_shared<section>(section_allocator(), section_name, get_memory_resource()));
+			sections_index_.push_back(sections_);
 		} else {
 			throw ambiguity_exception(section_name);
 		}
 	}
 
-	void config::remove_section(const std::string &section_name)
+	void config::remove_section(std::string_view section_name)
+	{
+		size_t del_pos = sections_index_.find(section_name, sections_);
+		if (del_pos != sections_index::npos) {
+			// remove from vector, positions of following sections are shifted, so index is built again
+			sections_.erase(sections_.begin() + static_cast<std::ptrdiff_t>(del_pos));
+			sections_index_.rebuild(sections_);
+		} else {
+			throw not_found_exception(std::string(section_name));
+		}
+	}
+
+	void config::add_option(std::string_view section_name, const option &opt)
 	{
-		auto del_it = sections_map_.find(section_name);
-		if (del_it != sections_map_.end()) {
-			// remove from map
-			sections_map_.erase(del_it);
-			// remove from vector
-			sections_.erase(
-				std::remove_if(sections_.begin(),
-					sections_.end(),
-					[&](std::shared_ptr<section> sect) { return (sect->get_name() == section_name ? true : false); }),
-				sections_.end());
+		size_t sect_pos = sections_index_.find(section_name, sections_);
+		if (sect_pos != sections_index::npos) {
+			sections_[sect_pos]->add_option(opt);
 		} else {
-			throw not_found_exception(section_name);
+			throw not_found_exception(std::string(section_name));
 		}
 	}
 
-	void config::add_option(const std::string &section_name, const option &opt)
+	void config::add_option(std::string_view section_name, option &&opt)
 	{
-		auto sect_it = sections_map_.find(section_name);
-		if (sect_it != sections_map_.end()) {
-			sect_it->second->add_option(opt);
+		size_t sect_pos = sections_index_.find(section_name, sections_);
+		if (sect_pos != sections_index::npos) {
+			sections_[sect_pos]->add_option(std::move(opt));
 		} else {
-			throw not_found_exception(section_name);
+			throw not_found_exception(std::string(section_name));
 		}
 	}
 
-	void config::remove_option(const std::string &section_name, const std::string &option_name)
+	void config::remove_option(std::string_view section_name, std::string_view option_name)
 	{
-		auto sect_it = sections_map_.find(section_name);
-		if (sect_it != sections_map_.end()) {
-			sect_it->second->remove_option(option_name);
+		size_t sect_pos = sections_index_.find(section_name, sections_);
+		if (sect_pos != sections_index::npos) {
+			sections_[sect_pos]->remove_option(option_name);
 		} else {
-			throw not_found_exception(section_name);
+			throw not_found_exception(std::string(section_name));
 		}
 	}
 
@@ -121,36 +185,101 @@ namespace inicpp
 		return *sections_[index];
 	}
 
-	section &config::operator[](const std::string &section_name)
+	section &config::operator[](std::string_view section_name)
 	{
-		std::shared_ptr<section> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (const std::out_of_range &) {
-			throw not_found_exception(section_name);
-		}
-		return *result;
+		size_t pos = sections_index_.find(section_name, sections_);
+		if (pos == sections_index::npos) { throw not_found_exception(std::string(section_name)); }
+
+		return *sections_[pos];
 	}
 
-	const section &config::operator[](const std::string &section_name) const
+	const section &config::operator[](std::string_view section_name) const
 	{
-		std::shared_ptr<section> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (const std::out_of_range &) {
-			throw not_found_exception(section_name);
-		}
-		return *result;
+		size_t pos = sections_index_.find(section_name, sections_);
+		if (pos == sections_index::npos) { throw not_found_exception(std::string(section_name)); }
+
+		return *sections_[pos];
 	}
 
-	bool config::contains(const std::string &section_name) const
+	bool config::contains(std::string_view section_name) const
 	{
-		try {
-			sections_map_.at(section_name);
-			return true;
-		} catch (const std::out_of_range &) {
-			return false;
-		}
+		return sections_index_.find(section_name, sections_) != sections_index::npos;
+	}
+
+	section *config::find(std::string_view section_name)
+	{
+		size_t pos = sections_index_.find(section_name, sections_);
+		return (pos == sections_index::npos ? nullptr : sections_[pos].get());
+	}
+
+	const section *config::find(std::string_view section_name) const
+	{
+		size_t pos = sections_index_.find(section_name, sections_);
+		return (pos == sections_index::npos ? nullptr : sections_[pos].get());
+	}
+
+	config::key_handle::key_handle(std::string section_name, std::string option_name)
+		: section_name_(std::move(section_name)), option_name_(std::move(option_name)), config_generation_(0),
+		  section_generation_(0), section_(nullptr), option_(nullptr)
+	{
+	}
+
+	const std::string &config::key_handle::section_name() const
+	{
+		return section_name_;
+	}
+
+	const std::string &config::key_handle::option_name() const
+	{
+		return option_name_;
+	}
+
+	const std::string &config::missing_name(const key_handle &handle) const
+	{
+		return (contains(handle.section_name_) ? handle.option_name_ : handle.section_name_);
+	}
+
+	option *config::resolve(key_handle &handle) const
+	{
+		// unresolved handle has zero generation, which is never current
+		handle.config_generation_ = 0;
+		handle.section_ = nullptr;
+		handle.option_ = nullptr;
+
+		size_t sect_pos = sections_index_.find(handle.section_name_, sections_);
+		if (sect_pos == sections_index::npos) { return nullptr; }
+		section &sect = *sections_[sect_pos];
+		size_t opt_pos = sect.options_index_.find(handle.option_name_, sect.options_);
+		if (opt_pos == section::options_index::npos) { return nullptr; }
+
+		handle.config_generation_ = sections_index_.generation();
+		handle.section_generation_ = sect.options_index_.generation();
+		handle.section_ = &sect;
+		handle.option_ = sect.options_[opt_pos].get();
+		return handle.option_;
+	}
+
+	config::key_handle config::handle(std::string_view section_name, std::string_view option_name) const
+	{
+		key_handle result{std::string(section_name), std::string(option_name)};
+		resolve(result);
+		return result;
+	}
+
+	option &config::operator[](key_handle &handle)
+	{
+		option *opt = find(handle);
+		if (opt == nullptr) { throw not_found_exception(missing_name(handle)); }
+
+		return *opt;
+	}
+
+	const option &config::operator[](key_handle &handle) const
+	{
+		const option *opt = find(handle);
+		if (opt == nullptr) { throw not_found_exception(missing_name(handle)); }
+
+		return *opt;
 	}
 
 	void config::validate(const schema &schm, schema_mode mode)
@@ -205,8 +334,9 @@ namespace inicpp
 
 	std::ostream &operator<<(std::ostream &os, const config &conf)
 	{
-		for (auto &sect : conf.sections_) { os << *sect; }
-
+		serializer writer(&os);
+		writer.write(conf);
+		writer.flush();
 		return os;
 	}
 } // namespace inicpp
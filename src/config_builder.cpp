@@ -0,0 +1,180 @@
+#include "config_builder.h"
+#include "scanner.h"
+#include "string_utils.h"
+#include "symbol_table.h"
+#include "tokenizer.h"
+
+namespace inicpp
+{
+	config_builder::config_builder(std::vector<deferred_link> *deferred_links,
+		bool lazy,
+		bool collect_errors,
+		std::pmr::memory_resource *resource,
+		symbol_table *symbols)
+		: cfg_(resource), last_section_(nullptr), deferred_links_(deferred_links), lazy_(lazy),
+		  collect_errors_(collect_errors), error_(), section_line_(0), section_offset_(0),
+		  symbols_(symbols)
+	{
+	}
+
+	void config_builder::finish_last_section()
+	{
+		if (symbols_ != nullptr) { last_section_->intern(*symbols_); }
+	}
+
+	bool config_builder::fail(load_error error)
+	{
+		if (!collect_errors_) { throw parser_exception(error.message()); }
+
+		if (!error_) { error_ = std::move(error); }
+		return false;
+	}
+
+	bool config_builder::on_section(std::string_view name)
+	{
+		if (last_section_ != nullptr) { finish_last_section(); }
+
+		section_line_ = line_number();
+		section_offset_ = line_offset();
+		if (collect_errors_ && cfg_.contains(name)) {
+			return fail(load_error(
+				load_error_code::duplicate_section, section_line_, 0, section_offset_, std::string(name)));
+		}
+
+		// section is built in place in the config, so it is allocated only once from its memory resource
+		last_section_ = &cfg_.emplace_section(std::string(name));
+		return true;
+	}
+
+	bool config_builder::on_option(std::string_view name, const std::vector<std::string_view> &values)
+	{
+		using namespace string_utils;
+
+		if (collect_errors_ && last_section_->contains(name)) {
+			return fail(
+				load_error(load_error_code::duplicate_option, line_number(), 0, line_offset(), std::string(name)));
+		}
+
+		std::vector<std::string> option_val_list;
+		if (lazy_) {
+			// links have to be resolved during loading, so only options which cannot contain them are deferred
+			std::string_view raw_value = values[0];
+			if (raw_value.find('$') == std::string_view::npos) {
+				last_section_->add_option(option(std::string(name), raw_value, option::lazy_tag()));
+				return true;
+			}
+			tokenizer::split_values(raw_value, option_val_list);
+		} else {
+			option_val_list.assign(values.begin(), values.end());
+		}
+
+		if (deferred_links_ == nullptr) {
+			load_error_code code;
+			if (!resolve_links(cfg_, *last_section_, option_val_list, code)) {
+				return fail(load_error(code, line_number(), 0, line_offset()));
+			}
+		} else {
+			// links can point to sections which are not known yet, they are resolved later
+			for (auto &value : option_val_list) {
+				if (starts_with(value, "${") && ends_with(value, "}")) {
+					deferred_links_->push_back({cfg_.size() - 1, last_section_->size(), line_number()});
+					break;
+				}
+			}
+		}
+
+		// and finally create option and store it in current section
+		last_section_->emplace_option(std::string(name), std::move(option_val_list));
+		return true;
+	}
+
+	bool config_builder::on_load_error(const load_error &error)
+	{
+		if (!collect_errors_) { return parse_handler::on_load_error(error); }
+
+		return fail(error);
+	}
+
+	config &config_builder::finish()
+	{
+		if (last_section_ != nullptr && !error_) { finish_last_section(); }
+		last_section_ = nullptr;
+
+		return cfg_;
+	}
+
+	const std::optional<load_error> &config_builder::error() const
+	{
+		return error_;
+	}
+
+	bool config_builder::resolve_links(const config &cfg,
+		const section &last_section,
+		std::vector<std::string> &option_val_list,
+		load_error_code &code,
+		size_t visible_options)
+	{
+		using namespace string_utils;
+
+		for (auto &opt_value : option_val_list) {
+			if (starts_with(opt_value, "${") && ends_with(opt_value, "}")) {
+				// parts of the link are only views, lookups by them do not allocate
+				std::string_view link = std::string_view(opt_value).substr(2, opt_value.length() - 3);
+				size_t delim = scanner::find_first_nonescaped(link, scanner::structural::hash);
+
+				// link always has to be in format "section#option"
+				// section and option cannot be empty
+				if (delim == std::string::npos || (delim + 1) == link.length()) {
+					code = load_error_code::bad_link_format;
+					return false;
+				}
+
+				std::string_view sect_link = link.substr(0, delim);
+				std::string_view opt_link = link.substr(delim + 1);
+
+				if (sect_link.empty()) {
+					code = load_error_code::empty_link_section;
+					return false;
+				}
+
+				// find section with name specifid in link
+				const section *selected_section =
+					(last_section.get_name() == sect_link ? &last_section : cfg.find(sect_link));
+				if (selected_section == nullptr) {
+					code = load_error_code::bad_link_section;
+					return false;
+				}
+
+				// options defined later in the same section cannot be linked yet
+				bool visible = true;
+				if (selected_section == &last_section && visible_options < last_section.size()) {
+					visible = false;
+					for (size_t i = 0; i < visible_options; ++i) {
+						if (last_section[i].get_name() == opt_link) { visible = true; }
+					}
+				}
+
+				// from selected section take appropriate option and set its value to options list
+				const option *linked_option = (visible ? selected_section->find(opt_link) : nullptr);
+				if (linked_option == nullptr) {
+					code = load_error_code::bad_link_option;
+					return false;
+				}
+				opt_value = linked_option->get<string_ini_t>();
+			}
+		}
+		return true;
+	}
+
+	void config_builder::handle_links(const config &cfg,
+		const section &last_section,
+		std::vector<std::string> &option_val_list,
+		size_t line_number,
+		size_t visible_options)
+	{
+		load_error_code code;
+		if (!resolve_links(cfg, last_section, option_val_list, code, visible_options)) {
+			throw parser_exception(load_error(code, line_number, 0, 0).message());
+		}
+	}
+} // namespace inicpp
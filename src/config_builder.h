@@ -0,0 +1,129 @@
+#ifndef INICPP_CONFIG_BUILDER_H
+#define INICPP_CONFIG_BUILDER_H
+
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "parse_handler.h"
+
+namespace inicpp
+{
+	/**
+	 * Option with link which was not resolved during parsing of a chunk.
+	 */
+	struct deferred_link {
+		/** Index of section in the chunk */
+		size_t section_index;
+		/** Index of option in the section */
+		size_t option_index;
+		/** Line of the option, used in error messages */
+		size_t line_number;
+	};
+
+	/**
+	 * Internal handler which builds config from parsed elements.
+	 * Errors are thrown by default implementation of on_error(), unless
+	 * the builder collects them, in which case the first error stops parsing.
+	 */
+	class config_builder : public parse_handler
+	{
+	private:
+		/** Config which is being built */
+		config cfg_;
+		/** Currently opened section, which is already stored in cfg_, nullptr if none */
+		section *last_section_;
+		/** If given, links are not resolved but stored here */
+		std::vector<deferred_link> *deferred_links_;
+		/** True if values are received unsplit from tokenizer and options are parsed on first access */
+		bool lazy_;
+		/** True if errors are stored in error_ instead of being thrown */
+		bool collect_errors_;
+		/** First error found if errors are collected */
+		std::optional<load_error> error_;
+		/** Line of the header of currently opened section, used in error messages */
+		size_t section_line_;
+		/** Offset of the header of currently opened section, used in error messages */
+		size_t section_offset_;
+		/** If given, names and values of finished sections are interned into it */
+		symbol_table *symbols_;
+
+		/**
+		 * Intern names and values of currently opened section, if symbol table is given.
+		 */
+		void finish_last_section();
+		/**
+		 * Store error if errors are collected, throw it otherwise.
+		 * @return always false, so that parsing stops
+		 * @throws parser_exception or ambiguity_exception if errors are not collected
+		 */
+		bool fail(load_error error);
+
+	public:
+		/**
+		 * Construct builder of empty config.
+		 * @param deferred_links if given, links are not resolved but stored here
+		 * @param lazy if true, tokenizer has to report raw values and options are parsed on first access
+		 * @param collect_errors if true, nothing is thrown on malformed input and the error is available
+		 *   through error() instead
+		 * @param resource memory resource of built config
+		 * @param symbols if given, names and values of built config are interned into it
+		 */
+		explicit config_builder(std::vector<deferred_link> *deferred_links = nullptr,
+			bool lazy = false,
+			bool collect_errors = false,
+			std::pmr::memory_resource *resource = std::pmr::get_default_resource(),
+			symbol_table *symbols = nullptr);
+
+		bool on_section(std::string_view name) override;
+		bool on_option(std::string_view name, const std::vector<std::string_view> &values) override;
+		bool on_load_error(const load_error &error) override;
+
+		/**
+		 * Finish building of the config.
+		 * @return built config, which is incomplete if error was collected
+		 */
+		config &finish();
+		/**
+		 * First collected error.
+		 * @return error or empty optional if there was none
+		 */
+		const std::optional<load_error> &error() const;
+
+		/**
+		 * Replace links in given list of values by values of linked options without throwing.
+		 * @param cfg config with already finished sections
+		 * @param last_section currently opened section
+		 * @param option_val_list values of processed option
+		 * @param code reason of the failure, set only if false is returned
+		 * @param visible_options number of options from @a last_section which can be linked,
+		 *   all of them by default
+		 * @return true if all links were resolved
+		 */
+		static bool resolve_links(const config &cfg,
+			const section &last_section,
+			std::vector<std::string> &option_val_list,
+			load_error_code &code,
+			size_t visible_options = std::string::npos);
+		/**
+		 * Replace links in given list of values by values of linked options.
+		 * @param cfg config with already finished sections
+		 * @param last_section currently opened section
+		 * @param option_val_list values of processed option
+		 * @param line_number number of the line, used in error messages
+		 * @param visible_options number of options from @a last_section which can be linked,
+		 *   all of them by default
+		 * @throws parser_exception if link is malformed or points to unknown option
+		 */
+		static void handle_links(const config &cfg,
+			const section &last_section,
+			std::vector<std::string> &option_val_list,
+			size_t line_number,
+			size_t visible_options = std::string::npos);
+	};
+} // namespace inicpp
+
+#endif // INICPP_CONFIG_BUILDER_H
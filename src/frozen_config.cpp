@@ -0,0 +1,455 @@
+#include "frozen_config.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace inicpp
+{
+	namespace
+	{
+		/** Multiplier which spreads displacements over the whole range of keys */
+		constexpr uint64_t displacement_step = 0x9e3779b97f4a7c15u;
+		/** Bucket which cannot be placed with so many displacements has colliding keys */
+		constexpr uint32_t max_displacement = 1u << 24;
+
+		/**
+		 * Narrow offset, length or count stored in records.
+		 * @throws exception if it does not fit into 32 bits
+		 */
+		uint32_t narrow(size_t value)
+		{
+			if (value > std::numeric_limits<uint32_t>::max()) {
+				throw exception("Config is too large to be frozen, names and values exceed 4 GiB or 2^32 elements");
+			}
+			return static_cast<uint32_t>(value);
+		}
+
+		/** Finalizer of splitmix64, which mixes all bits of the key */
+		uint64_t mix(uint64_t key)
+		{
+			key ^= key >> 30;
+			key *= 0xbf58476d1ce4e5b9u;
+			key ^= key >> 27;
+			key *= 0x94d049bb133111ebu;
+			key ^= key >> 31;
+			return key;
+		}
+
+		/** Key of section with given name */
+		uint64_t section_key(std::string_view section_name)
+		{
+			return static_cast<uint64_t>(std::hash<std::string_view>()(section_name));
+		}
+
+		/** Key of option with given name in section on given position */
+		uint64_t option_key(size_t section_position, std::string_view option_name)
+		{
+			return static_cast<uint64_t>(std::hash<std::string_view>()(option_name)) ^ mix(section_position + 1);
+		}
+
+		/** Map hash to range [0, count) without division */
+		size_t reduce(uint64_t hash, size_t count)
+		{
+			return static_cast<size_t>(((hash >> 32) * static_cast<uint64_t>(count)) >> 32);
+		}
+
+		/** Bucket of the key */
+		size_t bucket_of(uint64_t key, size_t count)
+		{
+			return reduce(mix(key), count);
+		}
+
+		/** Slot of the key in bucket with given displacement */
+		size_t slot_of(uint64_t key, uint32_t displacement, size_t count)
+		{
+			return reduce(mix(key + (displacement + uint64_t(1)) * displacement_step), count);
+		}
+
+		/** Encode boolean into stored value */
+		uint64_t encode(boolean_ini_t value, std::string &)
+		{
+			return value ? 1 : 0;
+		}
+		/** Encode signed integer into stored value */
+		uint64_t encode(signed_ini_t value, std::string &)
+		{
+			return static_cast<uint64_t>(value);
+		}
+		/** Encode unsigned integer into stored value */
+		uint64_t encode(unsigned_ini_t value, std::string &)
+		{
+			return value;
+		}
+		/** Encode floating point number into stored value */
+		uint64_t encode(float_ini_t value, std::string &)
+		{
+			uint64_t result;
+			std::memcpy(&result, &value, sizeof(result));
+			return result;
+		}
+		/** Append text to characters and encode its position and length into stored value */
+		uint64_t encode_text(std::string_view value, std::string &chars)
+		{
+			uint64_t offset = narrow(chars.size());
+			uint64_t length = narrow(value.size());
+			chars.append(value);
+			return offset | (length << 32);
+		}
+		/** Encode string into stored value */
+		uint64_t encode(const string_ini_t &value, std::string &chars)
+		{
+			return encode_text(value, chars);
+		}
+		/** Encode enum into stored value */
+		uint64_t encode(const enum_ini_t &value, std::string &chars)
+		{
+			return encode_text(static_cast<std::string>(value), chars);
+		}
+	} // namespace
+
+	template <typename ValueType>
+	bool frozen_config::pack_values(
+		const option &opt, option_record &record, std::vector<uint64_t> &values, std::string &chars)
+	{
+		if (!opt.holds_type<ValueType>()) { return false; }
+
+		record.type = type_of<ValueType>();
+		for (auto &&value : opt.values<ValueType>()) { values.push_back(encode(value, chars)); }
+		record.value_count = narrow(values.size() - record.first_value);
+		return true;
+	}
+
+	namespace
+	{
+		/**
+		 * Build minimal perfect hash table of given keys by hash and displace algorithm.
+		 * Keys are distributed into as many buckets as there are keys, then buckets
+		 * from the largest one are given the lowest displacement which moves all their
+		 * keys to free slots. Slot of each key holds position of the key.
+		 * @throws ambiguity_exception if two keys are equal, with name of the key returned by @a name_of
+		 */
+		template <typename Entry, typename NameOf>
+		void build_table(const std::vector<uint64_t> &keys, Entry *table, NameOf name_of)
+		{
+			// equal keys can never be placed into different slots, so they are rejected before the search
+			std::vector<uint64_t> sorted(keys);
+			std::sort(sorted.begin(), sorted.end());
+			auto duplicate = std::adjacent_find(sorted.begin(), sorted.end());
+			if (duplicate != sorted.end()) {
+				auto position = std::find(keys.begin(), keys.end(), *duplicate) - keys.begin();
+				throw ambiguity_exception(name_of(static_cast<size_t>(position)));
+			}
+
+			size_t count = keys.size();
+			std::vector<std::vector<uint32_t>> buckets(count);
+			for (size_t i = 0; i < count; ++i) {
+				buckets[bucket_of(keys[i], count)].push_back(static_cast<uint32_t>(i));
+			}
+
+			std::vector<uint32_t> order(count);
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&buckets](uint32_t first, uint32_t second) {
+				return buckets[first].size() > buckets[second].size();
+			});
+
+			std::vector<bool> taken(count, false);
+			std::vector<size_t> slots;
+			for (uint32_t bucket : order) {
+				const std::vector<uint32_t> &bucket_keys = buckets[bucket];
+				if (bucket_keys.empty()) { break; }
+
+				for (uint32_t displacement = 0;; ++displacement) {
+					if (displacement == max_displacement) { throw exception("Perfect hash of names cannot be built"); }
+
+					slots.clear();
+					for (uint32_t key : bucket_keys) {
+						size_t slot = slot_of(keys[key], displacement, count);
+						if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) { break; }
+						slots.push_back(slot);
+					}
+					if (slots.size() != bucket_keys.size()) { continue; }
+
+					table[bucket].displacement = displacement;
+					for (size_t i = 0; i < slots.size(); ++i) {
+						taken[slots[i]] = true;
+						table[slots[i]].element = bucket_keys[i];
+					}
+					break;
+				}
+			}
+		}
+
+		/** Look up position of element with given key in perfect hash table of given size */
+		template <typename Entry> uint32_t lookup(const Entry *table, size_t count, uint64_t key)
+		{
+			return table[slot_of(key, table[bucket_of(key, count)].displacement, count)].element;
+		}
+	} // namespace
+
+	frozen_config::frozen_config() : buffer_(), layout_(), section_count_(0), option_count_(0)
+	{
+	}
+
+	frozen_config::frozen_config(const config &cfg) : frozen_config()
+	{
+		std::vector<section_record> sections;
+		std::vector<option_record> options;
+		std::vector<uint64_t> values;
+		std::vector<uint64_t> section_keys;
+		std::vector<uint64_t> option_keys;
+		std::string chars;
+
+		// gather all records, names and values
+		for (const auto &sect : cfg) {
+			size_t section_position = sections.size();
+			section_record sect_record{
+				narrow(chars.size()), narrow(sect.get_name().size()), narrow(options.size()), narrow(sect.size())};
+			chars.append(sect.get_name());
+			sections.push_back(sect_record);
+			section_keys.push_back(section_key(sect.get_name()));
+
+			for (const auto &opt : sect) {
+				option_record opt_record{narrow(chars.size()),
+					narrow(opt.get_name().size()),
+					narrow(values.size()),
+					0,
+					narrow(section_position),
+					type_of<string_ini_t>()};
+				chars.append(opt.get_name());
+				// empty option keeps string type, values of other options are packed as they are stored
+				if (opt.size() > 0 && !pack_values<boolean_ini_t>(opt, opt_record, values, chars) &&
+					!pack_values<signed_ini_t>(opt, opt_record, values, chars) &&
+					!pack_values<unsigned_ini_t>(opt, opt_record, values, chars) &&
+					!pack_values<float_ini_t>(opt, opt_record, values, chars) &&
+					!pack_values<enum_ini_t>(opt, opt_record, values, chars)) {
+					pack_values<string_ini_t>(opt, opt_record, values, chars);
+				}
+				options.push_back(opt_record);
+				option_keys.push_back(option_key(section_position, opt.get_name()));
+			}
+		}
+		section_count_ = narrow(sections.size());
+		option_count_ = narrow(options.size());
+
+		// place all parts into one buffer, each part is aligned to 8 bytes
+		auto align = [](size_t offset) { return (offset + 7) / 8 * 8; };
+		layout_.sections = 0;
+		layout_.options = align(layout_.sections + sections.size() * sizeof(section_record));
+		layout_.values = align(layout_.options + options.size() * sizeof(option_record));
+		layout_.section_table = layout_.values + values.size() * sizeof(uint64_t);
+		layout_.option_table = layout_.section_table + sections.size() * sizeof(hash_entry);
+		layout_.chars = layout_.option_table + options.size() * sizeof(hash_entry);
+		layout_.size = layout_.chars + chars.size();
+
+		buffer_ = std::make_unique<std::byte[]>(layout_.size);
+		std::byte *base = buffer_.get();
+		std::uninitialized_copy(sections.begin(), sections.end(), reinterpret_cast<section_record *>(base));
+		std::uninitialized_copy(
+			options.begin(), options.end(), reinterpret_cast<option_record *>(base + layout_.options));
+		std::uninitialized_copy(values.begin(), values.end(), reinterpret_cast<uint64_t *>(base + layout_.values));
+		auto section_table = reinterpret_cast<hash_entry *>(base + layout_.section_table);
+		auto option_table = reinterpret_cast<hash_entry *>(base + layout_.option_table);
+		std::uninitialized_value_construct_n(section_table, sections.size());
+		std::uninitialized_value_construct_n(option_table, options.size());
+		std::copy(chars.begin(), chars.end(), reinterpret_cast<char *>(base + layout_.chars));
+
+		build_table(section_keys, section_table, [&sections, &chars](size_t position) {
+			return chars.substr(sections[position].name_offset, sections[position].name_length);
+		});
+		build_table(option_keys, option_table, [&options, &chars](size_t position) {
+			return chars.substr(options[position].name_offset, options[position].name_length);
+		});
+	}
+
+	frozen_config::frozen_config(const frozen_config &source)
+		: buffer_(), layout_(source.layout_), section_count_(source.section_count_),
+		  option_count_(source.option_count_)
+	{
+		// all parts are trivially copyable and referenced only by their offsets
+		if (source.buffer_ != nullptr) {
+			buffer_ = std::make_unique<std::byte[]>(layout_.size);
+			std::memcpy(buffer_.get(), source.buffer_.get(), layout_.size);
+		}
+	}
+
+	frozen_config &frozen_config::operator=(const frozen_config &source)
+	{
+		if (this != &source) { operator=(frozen_config(source)); }
+		return *this;
+	}
+
+	frozen_config::frozen_config(frozen_config &&source) noexcept
+		: buffer_(std::move(source.buffer_)), layout_(source.layout_), section_count_(source.section_count_),
+		  option_count_(source.option_count_)
+	{
+		source.section_count_ = 0;
+		source.option_count_ = 0;
+	}
+
+	frozen_config &frozen_config::operator=(frozen_config &&source) noexcept
+	{
+		if (this != &source) {
+			buffer_ = std::move(source.buffer_);
+			layout_ = source.layout_;
+			section_count_ = source.section_count_;
+			option_count_ = source.option_count_;
+			source.section_count_ = 0;
+			source.option_count_ = 0;
+		}
+		return *this;
+	}
+
+	size_t frozen_config::find_section(std::string_view section_name) const
+	{
+		if (section_count_ == 0) { return npos; }
+
+		// perfect hash gives the only candidate, which is the section if it exists
+		uint32_t position =
+			lookup(part<hash_entry>(layout_.section_table), section_count_, section_key(section_name));
+		const section_record &record = section_at(position);
+		return (text(record.name_offset, record.name_length) == section_name ? position : npos);
+	}
+
+	size_t frozen_config::find_option(size_t section_position, std::string_view option_name) const
+	{
+		if (option_count_ == 0) { return npos; }
+
+		uint32_t position = lookup(
+			part<hash_entry>(layout_.option_table), option_count_, option_key(section_position, option_name));
+		const option_record &record = option_at(position);
+		if (record.section != section_position || text(record.name_offset, record.name_length) != option_name) {
+			return npos;
+		}
+		return position;
+	}
+
+	size_t frozen_config::size() const
+	{
+		return section_count_;
+	}
+
+	frozen_section frozen_config::operator[](size_t index) const
+	{
+		if (index >= section_count_) { throw not_found_exception(index); }
+		return frozen_section(*this, index);
+	}
+
+	frozen_section frozen_config::operator[](std::string_view section_name) const
+	{
+		size_t position = find_section(section_name);
+		if (position == npos) { throw not_found_exception(std::string(section_name)); }
+		return frozen_section(*this, position);
+	}
+
+	bool frozen_config::contains(std::string_view section_name) const
+	{
+		return find_section(section_name) != npos;
+	}
+
+	std::optional<frozen_section> frozen_config::find(std::string_view section_name) const
+	{
+		size_t position = find_section(section_name);
+		if (position == npos) { return std::nullopt; }
+		return frozen_section(*this, position);
+	}
+
+	size_t frozen_config::memory_usage() const
+	{
+		return (buffer_ != nullptr ? layout_.size : 0);
+	}
+
+	frozen_config::const_iterator frozen_config::begin() const
+	{
+		return const_iterator(*this, 0);
+	}
+
+	frozen_config::const_iterator frozen_config::end() const
+	{
+		return const_iterator(*this, section_count_);
+	}
+
+
+	frozen_option::frozen_option(const frozen_config &cfg, const frozen_config::option_record &record)
+		: config_(&cfg), record_(&record)
+	{
+	}
+
+	option_value frozen_option::value(size_t index) const
+	{
+		switch (record_->type) {
+		case frozen_config::type_of<boolean_ini_t>(): return stored<boolean_ini_t>(index);
+		case frozen_config::type_of<signed_ini_t>(): return stored<signed_ini_t>(index);
+		case frozen_config::type_of<unsigned_ini_t>(): return stored<unsigned_ini_t>(index);
+		case frozen_config::type_of<float_ini_t>(): return stored<float_ini_t>(index);
+		case frozen_config::type_of<enum_ini_t>(): return stored<enum_ini_t>(index);
+		default: return stored<string_ini_t>(index);
+		}
+	}
+
+	std::string_view frozen_option::get_name() const
+	{
+		return config_->text(record_->name_offset, record_->name_length);
+	}
+
+	size_t frozen_option::size() const
+	{
+		return record_->value_count;
+	}
+
+	bool frozen_option::is_list() const
+	{
+		return record_->value_count > 1;
+	}
+
+
+	frozen_section::frozen_section(const frozen_config &cfg, size_t position) : config_(&cfg), position_(position)
+	{
+	}
+
+	std::string_view frozen_section::get_name() const
+	{
+		return config_->text(record().name_offset, record().name_length);
+	}
+
+	size_t frozen_section::size() const
+	{
+		return record().option_count;
+	}
+
+	frozen_option frozen_section::operator[](size_t index) const
+	{
+		if (index >= record().option_count) { throw not_found_exception(index); }
+		return frozen_option(*config_, config_->option_at(record().first_option + index));
+	}
+
+	frozen_option frozen_section::operator[](std::string_view option_name) const
+	{
+		size_t position = config_->find_option(position_, option_name);
+		if (position == frozen_config::npos) { throw not_found_exception(std::string(option_name)); }
+		return frozen_option(*config_, config_->option_at(position));
+	}
+
+	bool frozen_section::contains(std::string_view option_name) const
+	{
+		return config_->find_option(position_, option_name) != frozen_config::npos;
+	}
+
+	std::optional<frozen_option> frozen_section::find(std::string_view option_name) const
+	{
+		size_t position = config_->find_option(position_, option_name);
+		if (position == frozen_config::npos) { return std::nullopt; }
+		return frozen_option(*config_, config_->option_at(position));
+	}
+
+	frozen_section::const_iterator frozen_section::begin() const
+	{
+		return const_iterator(*this, 0);
+	}
+
+	frozen_section::const_iterator frozen_section::end() const
+	{
+		return const_iterator(*this, record().option_count);
+	}
+} // namespace inicpp
@@ -0,0 +1,51 @@
+#include "load_error.h"
+
+namespace inicpp
+{
+	load_error::load_error(load_error_code code, size_t line, size_t column, size_t offset, std::string detail)
+		: code_(code), line_(line), column_(column), offset_(offset), detail_(std::move(detail))
+	{
+	}
+
+	load_error_code load_error::code() const
+	{
+		return code_;
+	}
+
+	size_t load_error::line() const
+	{
+		return line_;
+	}
+
+	size_t load_error::column() const
+	{
+		return column_;
+	}
+
+	size_t load_error::offset() const
+	{
+		return offset_;
+	}
+
+	std::string load_error::message() const
+	{
+		const char *text = "";
+		switch (code_) {
+		case load_error_code::section_not_ended: text = "Section not ended on line "; break;
+		case load_error_code::empty_section_name: text = "Section name cannot be empty on line "; break;
+		case load_error_code::invalid_identifier: text = "Identifier contains forbidden characters on line "; break;
+		case load_error_code::option_expected: text = "Unknown element option expected on line "; break;
+		case load_error_code::option_not_in_section: text = "Option not in section on line "; break;
+		case load_error_code::empty_option_value: text = "Option value cannot be empty on line "; break;
+		case load_error_code::bad_link_format: text = "Bad format of link on line "; break;
+		case load_error_code::empty_link_section: text = "Section name in link cannot be empty on line "; break;
+		case load_error_code::bad_link_section: text = "Bad link on line "; break;
+		case load_error_code::bad_link_option: text = "Option name in link not found on line "; break;
+		case load_error_code::duplicate_section:
+		case load_error_code::duplicate_option: return "Ambiguous element with name: " + detail_;
+		case load_error_code::file_not_readable: return "File reading error";
+		case load_error_code::validation_failed: return detail_;
+		}
+		return text + std::to_string(line_);
+	}
+} // namespace inicpp
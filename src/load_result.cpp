@@ -0,0 +1,61 @@
+#include "load_result.h"
+
+namespace inicpp
+{
+	load_result::load_result(config &&cfg) : result_(std::move(cfg))
+	{
+	}
+
+	load_result::load_result(load_error error) : result_(std::move(error))
+	{
+	}
+
+	bool load_result::has_value() const
+	{
+		return std::holds_alternative<config>(result_);
+	}
+
+	load_result::operator bool() const
+	{
+		return has_value();
+	}
+
+	config &load_result::value()
+	{
+		if (!has_value()) { throw parser_exception(error().message()); }
+
+		return std::get<config>(result_);
+	}
+
+	const config &load_result::value() const
+	{
+		if (!has_value()) { throw parser_exception(error().message()); }
+
+		return std::get<config>(result_);
+	}
+
+	config &load_result::operator*()
+	{
+		return *std::get_if<config>(&result_);
+	}
+
+	const config &load_result::operator*() const
+	{
+		return *std::get_if<config>(&result_);
+	}
+
+	config *load_result::operator->()
+	{
+		return std::get_if<config>(&result_);
+	}
+
+	const config *load_result::operator->() const
+	{
+		return std::get_if<config>(&result_);
+	}
+
+	const load_error &load_result::error() const
+	{
+		return *std::get_if<load_error>(&result_);
+	}
+} // namespace inicpp
@@ -0,0 +1,13 @@
+#include "name_index.h"
+
+#include <atomic>
+
+namespace inicpp
+{
+	uint64_t next_layout_generation()
+	{
+		// zero is never returned, so it can mark elements which were not found at all
+		static std::atomic<uint64_t> last_generation(0);
+		return last_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+} // namespace inicpp
@@ -1,8 +1,27 @@
 #include "option.h"
+#include "serializer.h"
+#include "symbol_table.h"
+#include "tokenizer.h"
+
+#include <mutex>
 
 namespace inicpp
 {
-	option::option(const option &source) : name_(), values_(), option_schema_()
+	namespace
+	{
+		/**
+		 * Lock which serializes parsing of raw value of given option.
+		 * Concurrent readers of the same option are serialized by one of shared locks.
+		 */
+		std::mutex &raw_value_lock(const option *opt)
+		{
+			static std::mutex locks[16];
+			return locks[std::hash<const option *>()(opt) % 16];
+		}
+	} // namespace
+
+	option::option(const option &source)
+		: name_(), symbol_(nullptr), values_(), lazy_(false), version_(0), typed_values_(nullptr)
 	{
 		this->operator=(source);
 	}
@@ -10,52 +29,129 @@ namespace inicpp
 	option &option::operator=(const option &source)
 	{
 		if (&source != this) {
-			values_.clear();
-			name_ = source.name_;
-			for (const auto &value : source.values_) { values_.push_back(value); }
-			option_schema_ = source.option_schema_;
+			invalidate_typed_values();
+			if (!indexed_) {
+				name_ = source.name_;
+				symbol_ = source.symbol_;
+			}
+			// unparsed option stays unparsed in the copy, source must not be parsed in the middle of copying
+			if (source.lazy_.load(std::memory_order_acquire)) {
+				std::lock_guard<std::mutex> guard(raw_value_lock(&source));
+				values_ = source.values_;
+				lazy_.store(source.lazy_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			} else {
+				values_ = source.values_;
+				lazy_.store(false, std::memory_order_relaxed);
+			}
 		}
 		return *this;
 	}
 
-	option::option(option &&source) : name_(), values_(), option_schema_()
+	option::option(option &&source)
+		: name_(std::move(source.name_)), symbol_(source.symbol_), values_(std::move(source.values_)),
+		  lazy_(source.lazy_.load(std::memory_order_relaxed)), version_(0),
+		  typed_values_(source.typed_values_.exchange(nullptr))
 	{
-		name_ = source.name_;
-		values_ = std::move(source.values_);
-		option_schema_ = std::move(source.option_schema_);
+		// raw value was moved out together with values
+		source.lazy_.store(false, std::memory_order_relaxed);
 	}
 
 	option &option::operator=(option &&source)
 	{
 		if (&source != this) {
-			name_ = source.name_;
+			if (!indexed_) {
+				name_ = std::move(source.name_);
+				symbol_ = source.symbol_;
+			}
 			values_ = std::move(source.values_);
-			option_schema_ = std::move(source.option_schema_);
+			lazy_.store(source.lazy_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			source.lazy_.store(false, std::memory_order_relaxed);
+			invalidate_typed_values();
+			typed_values_.store(source.typed_values_.exchange(nullptr));
 		}
 		return *this;
 	}
 
-	option::option(const std::string &name, const std::string &value) : name_(name), values_(), option_schema_()
+	option::~option()
 	{
-		add_to_list<string_ini_t>(value);
+		invalidate_typed_values();
 	}
 
-	option::option(const std::string &name, const std::vector<std::string> &values)
-		: name_(name), values_(), option_schema_()
+	option::option(std::string name, std::string value)
+		: name_(std::move(name)), symbol_(nullptr), values_(), lazy_(false), version_(0), typed_values_(nullptr)
 	{
-		for (const auto &input_value : values) { add_to_list<string_ini_t>(input_value); }
+		add_to_list<string_ini_t>(std::move(value));
+	}
+
+	option::option(std::string name, const std::vector<std::string> &values)
+		: name_(std::move(name)), symbol_(nullptr), values_(values), lazy_(false), version_(0), typed_values_(nullptr)
+	{
+	}
+
+	option::option(std::string name, std::vector<std::string> &&values)
+		: name_(std::move(name)), symbol_(nullptr), values_(std::move(values)), lazy_(false), version_(0),
+		  typed_values_(nullptr)
+	{
+	}
+
+	option::option(std::string name, std::string_view raw_value, lazy_tag)
+		: name_(std::move(name)), symbol_(nullptr), values_(), lazy_(true), version_(0), typed_values_(nullptr)
+	{
+		values_.push_back<string_ini_t>(std::string(raw_value));
+	}
+
+	void option::materialize() const
+	{
+		if (!lazy_.load(std::memory_order_acquire)) { return; }
+
+		std::lock_guard<std::mutex> guard(raw_value_lock(this));
+		if (lazy_.load(std::memory_order_relaxed)) {
+			std::vector<std::string> list;
+			tokenizer::split_values(values_.string_at(0), list);
+			values_ = value_list(std::move(list));
+			lazy_.store(false, std::memory_order_release);
+		}
+	}
+
+	void option::clear_values()
+	{
+		invalidate_typed_values();
+		values_.clear();
+		lazy_.store(false, std::memory_order_relaxed);
+	}
+
+	void option::store_typed_values(value_list *typed) const
+	{
+		// only the first stored conversion is kept, later ones are always computed again
+		value_list *expected = nullptr;
+		if (!typed_values_.compare_exchange_strong(expected, typed, std::memory_order_acq_rel)) { delete typed; }
+	}
+
+	void option::invalidate_typed_values()
+	{
+		++version_;
+		delete typed_values_.exchange(nullptr);
 	}
 
 	const std::string &option::get_name() const
 	{
-		return name_;
+		return (symbol_ != nullptr ? *symbol_ : name_);
 	}
 
 	void option::remove_from_list_pos(size_t position)
 	{
+		materialize();
 		if (position >= values_.size()) { throw not_found_exception(position); }
-		auto p = static_cast<std::iterator_traits<decltype(values_.begin())>::difference_type>(position);
-		values_.erase(std::next(values_.begin(), p));
+		invalidate_typed_values();
+		values_.erase(position);
+	}
+
+	void option::intern(symbol_table &symbols)
+	{
+		symbol_ = &symbols.intern(get_name());
+		name_.clear();
+		name_.shrink_to_fit();
+		values_.intern(symbols);
 	}
 
 	void option::validate(const option_schema &opt_schema)
@@ -65,15 +161,13 @@ namespace inicpp
 
 	bool option::operator==(const option &other) const
 	{
-		if (name_ != other.name_) { return false; }
-
-		if (values_.size() != other.values_.size()) { return false; }
+		// interned names are equal if they are the same symbol
+		if (&get_name() != &other.get_name() && get_name() != other.get_name()) { return false; }
 
-		for (size_t i = 0; i < values_.size(); ++i) {
-			if (values_[i] != other.values_[i]) { return false; }
-		}
+		materialize();
+		other.materialize();
 
-		return true;
+		return values_ == other.values_;
 	}
 
 	bool option::operator!=(const option &other) const
@@ -81,122 +175,72 @@ namespace inicpp
 		return !(*this == other);
 	}
 
+	size_t option::size() const
+	{
+		materialize();
+		return values_.size();
+	}
+
 	bool option::is_list() const
 	{
+		materialize();
 		return values_.size() > 1;
 	}
 
 	option &option::operator=(boolean_ini_t arg)
 	{
-		values_.clear();
+		clear_values();
 		add_to_list<boolean_ini_t>(arg);
 		return *this;
 	}
 
 	option &option::operator=(signed_ini_t arg)
 	{
-		values_.clear();
+		clear_values();
 		add_to_list<signed_ini_t>(arg);
 		return *this;
 	}
 
 	option &option::operator=(unsigned_ini_t arg)
 	{
-		values_.clear();
+		clear_values();
 		add_to_list<unsigned_ini_t>(arg);
 		return *this;
 	}
 
 	option &option::operator=(float_ini_t arg)
 	{
-		values_.clear();
+		clear_values();
 		add_to_list<float_ini_t>(arg);
 		return *this;
 	}
 
 	option &option::operator=(const char *arg)
 	{
-		values_.clear();
+		clear_values();
 		add_to_list<string_ini_t>(arg);
 		return *this;
 	}
 
 	option &option::operator=(string_ini_t arg)
 	{
-		values_.clear();
-		add_to_list<string_ini_t>(arg);
+		clear_values();
+		add_to_list<string_ini_t>(std::move(arg));
 		return *this;
 	}
 
 	option &option::operator=(enum_ini_t arg)
 	{
-		values_.clear();
-		add_to_list<enum_ini_t>(arg);
+		clear_values();
+		add_to_list<enum_ini_t>(std::move(arg));
 		return *this;
 	}
 
-	// ----- Write functions -----
-
-	// Internal type specific functions
-	namespace
-	{
-		void write_boolean_option(std::vector<boolean_ini_t> values, std::ostream &os)
-		{
-			if (values[0]) {
-				os << "yes";
-			} else {
-				os << "no";
-			}
-			for (auto it = values.begin() + 1; it != values.end(); ++it) {
-				os << ",";
-				if (*it) {
-					os << "yes";
-				} else {
-					os << "no";
-				}
-			}
-		}
-		void write_enum_option(std::vector<enum_ini_t> values, std::ostream &os)
-		{
-			os << escape_option_value(static_cast<std::string>(values[0]));
-			for (auto it = values.begin() + 1; it != values.end(); ++it) {
-				os << "," << escape_option_value(static_cast<std::string>(*it));
-			}
-		}
-		void write_float_option(std::vector<float_ini_t> values, std::ostream &os)
-		{
-			os << values[0];
-			for (auto it = values.begin() + 1; it != values.end(); ++it) { os << "," << *it; }
-		}
-		void write_signed_option(std::vector<signed_ini_t> values, std::ostream &os)
-		{
-			os << values[0];
-			for (auto it = values.begin() + 1; it != values.end(); ++it) { os << "," << *it; }
-		}
-		void write_unsigned_option(std::vector<unsigned_ini_t> values, std::ostream &os)
-		{
-			os << values[0];
-			for (auto it = values.begin() + 1; it != values.end(); ++it) { os << "," << *it; }
-		}
-		void write_string_option(std::vector<string_ini_t> values, std::ostream &os)
-		{
-			os << escape_option_value(values[0]);
-			for (auto it = values.begin() + 1; it != values.end(); ++it) { os << "," << escape_option_value(*it); }
-		}
-	} // namespace
-
 	std::ostream &operator<<(std::ostream &os, const option &opt)
 	{
-		os << opt.name_ << " = ";
-		std::visit(overloaded{[&](boolean_ini_t) { write_boolean_option(opt.get_list<boolean_ini_t>(), os); },
-					   [&](enum_ini_t) { write_enum_option(opt.get_list<enum_ini_t>(), os); },
-					   [&](float_ini_t) { write_float_option(opt.get_list<float_ini_t>(), os); },
-					   [&](signed_ini_t) { write_signed_option(opt.get_list<signed_ini_t>(), os); },
-					   [&](unsigned_ini_t) { write_unsigned_option(opt.get_list<unsigned_ini_t>(), os); },
-					   [&](string_ini_t) { write_string_option(opt.get_list<string_ini_t>(), os); }},
-			opt.values_[0]);
-
-		os << std::endl;
+		serializer writer(&os);
+		writer.write(opt);
+		writer.flush();
 		return os;
 	}
 } // namespace inicpp
@@ -3,14 +3,13 @@
 
 namespace inicpp
 {
-	option_schema::option_schema(const option_schema &source) : params_()
+	option_schema::option_schema(const option_schema &source) : params_(source.params_)
 	{
-		this->operator=(source);
 	}
 
 	option_schema &option_schema::operator=(const option_schema &source)
 	{
-		params_ = source.params_;
+		if (this != &source) { operator=(option_schema(source)); }
 
 		return *this;
 	}
@@ -22,13 +21,22 @@ namespace inicpp
 
 	option_schema &option_schema::operator=(option_schema &&source)
 	{
-		if (this != &source) { params_ = std::move(source.params_); }
+		if (this != &source) {
+			if (indexed_) {
+				// option schema stored in section schema keeps its name, which it is found by
+				std::string name = get_name();
+				params_ = std::move(source.params_);
+				std::visit([&name](auto &arg) { arg.name = std::move(name); }, params_);
+			} else {
+				params_ = std::move(source.params_);
+			}
+		}
 		return *this;
 	}
 
-	std::string option_schema::get_name() const
+	const std::string &option_schema::get_name() const
 	{
-		return std::visit([](const auto &arg) { return arg.name; }, params_);
+		return std::visit([](const auto &arg) -> const std::string & { return arg.name; }, params_);
 	}
 
 	bool option_schema::is_list() const
@@ -89,16 +97,16 @@ namespace inicpp
 	{
 		// write comment
 		auto comment_lines = string_utils::split(get_comment(), '\n');
-		for (auto &comment_line : comment_lines) { os << ";" << comment_line << std::endl; }
+		for (auto &comment_line : comment_lines) { os << ";" << comment_line << '\n'; }
 
 		// optional/mandatory and single/list
 		std::string info_line = is_mandatory() ? "mandatory" : "optional";
 		info_line += ", ";
 		info_line += is_list() ? "list" : "single";
-		os << ";<" << info_line << ">" << std::endl;
+		os << ";<" << info_line << ">" << '\n';
 
 		// default value given at construction
-		os << ";<default value: \"" << get_default_value() << "\">" << std::endl;
+		os << ";<default value: \"" << get_default_value() << "\">" << '\n';
 
 		return os;
 	}
@@ -109,7 +117,7 @@ namespace inicpp
 		opt_schema.write_additional_info(os);
 
 		// write name and default value
-		os << opt_schema.get_name() << " = " << opt_schema.get_default_value() << std::endl;
+		os << opt_schema.get_name() << " = " << opt_schema.get_default_value() << '\n';
 
 		return os;
 	}
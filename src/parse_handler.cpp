@@ -0,0 +1,47 @@
+#include "parse_handler.h"
+
+namespace inicpp
+{
+	parse_handler::parse_handler() : line_number_(0), line_offset_(0)
+	{
+	}
+
+	parse_handler::~parse_handler()
+	{
+	}
+
+	bool parse_handler::on_section(std::string_view)
+	{
+		return true;
+	}
+
+	bool parse_handler::on_option(std::string_view, const std::vector<std::string_view> &)
+	{
+		return true;
+	}
+
+	bool parse_handler::on_comment(std::string_view)
+	{
+		return true;
+	}
+
+	bool parse_handler::on_error(const parser_exception &error)
+	{
+		throw error;
+	}
+
+	bool parse_handler::on_load_error(const load_error &error)
+	{
+		return on_error(parser_exception(error.message()));
+	}
+
+	size_t parse_handler::line_number() const
+	{
+		return line_number_;
+	}
+
+	size_t parse_handler::line_offset() const
+	{
+		return line_offset_;
+	}
+} // namespace inicpp
@@ -1,253 +1,206 @@
 #include "parser.h"
+#include "scanner.h"
+#include "serializer.h"
+#include "config_builder.h"
+#include "tokenizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define INICPP_HAS_MMAP
+#endif
 
 namespace inicpp
 {
-	size_t parser::find_first_nonescaped(const std::string &str, char ch)
-	{
-		size_t result = std::string::npos;
-		bool escaped = false;
-
-		for (size_t i = 0; i < str.length(); ++i) {
-			if (escaped) {
-				// escaped character, do not do anything
-				escaped = false;
-			} else if (str[i] == '\\') {
-				// next character will be escaped
-				escaped = true;
-			} else if (str[i] == ch) {
-				// we tracked down non escaped character... return it
-				result = i;
-				break;
-			}
-		}
-
-		return result;
-	}
-
-	size_t parser::find_last_escaped(const std::string &str, char ch)
+#ifdef INICPP_HAS_MMAP
+	namespace
 	{
-		size_t result = std::string::npos;
-		bool escaped = false;
+		/**
+		 * Read-only memory mapping of whole file. If the file cannot be mapped
+		 * for any reason, is_mapped() returns false and caller should fall back
+		 * to the stream based reading.
+		 */
+		class mapped_file
+		{
+		private:
+			/** Beginning of the mapped memory */
+			void *data_ = nullptr;
+			/** Length of mapped file in bytes */
+			size_t size_ = 0;
+			/** True if file was successfully mapped (or is empty) */
+			bool mapped_ = false;
+
+		public:
+			mapped_file(const std::string &file)
+			{
+				int fd = ::open(file.c_str(), O_RDONLY);
+				if (fd < 0) { return; }
+
+				struct stat info;
+				if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size >= 0 &&
+					static_cast<unsigned long long>(info.st_size) <= std::numeric_limits<size_t>::max()) {
+					size_ = static_cast<size_t>(info.st_size);
+					if (size_ == 0) {
+						// empty file cannot be mapped, but there is nothing to parse anyway
+						mapped_ = true;
+					} else {
+						data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+						if (data_ != MAP_FAILED) {
+							mapped_ = true;
+							// file is parsed from the beginning to the end, hint the kernel
+							::madvise(data_, size_, MADV_SEQUENTIAL);
+						} else {
+							data_ = nullptr;
+						}
+					}
+				}
 
-		for (size_t i = 0; i < str.length(); ++i) {
-			if (escaped) {
-				// escaped character, do not do anything
-				escaped = false;
+				// mapping stays valid even after closing the descriptor
+				::close(fd);
+			}
 
-				if (str[i] == ch) { result = i; }
-			} else if (str[i] == '\\') {
-				// next character will be escaped
-				escaped = true;
+			~mapped_file()
+			{
+				if (data_ != nullptr) { ::munmap(data_, size_); }
 			}
-		}
 
-		return result;
-	}
+			mapped_file(const mapped_file &) = delete;
+			mapped_file &operator=(const mapped_file &) = delete;
 
-	std::string parser::unescape(const std::string &str)
-	{
-		std::string result = str;
-		bool escaped = false;
+			bool is_mapped() const
+			{
+				return mapped_;
+			}
 
-		auto it = result.begin();
-		while (it != result.end()) {
-			if (escaped) {
-				// escaped character, it should remain in string
-				escaped = false;
-			} else if (*it == '\\') {
-				// next character will be escaped, so delete escaping character
-				escaped = true;
-				it = result.erase(it);
-				continue;
+			const char *data() const
+			{
+				return static_cast<const char *>(data_);
 			}
 
-			// we have while cycle so we have to do this manually
-			++it;
-		}
+			size_t size() const
+			{
+				return size_;
+			}
+		};
+	} // namespace
+#endif
 
-		return result;
+	config parser::internal_load(
+		std::istream &str, bool lazy, std::pmr::memory_resource *resource, symbol_table *symbols)
+	{
+		config_builder builder(nullptr, lazy, false, resource, symbols);
+		tokenizer(builder, lazy).process_stream(str);
+		return std::move(builder.finish());
 	}
 
-	std::string parser::delete_comment(const std::string &str)
+	config parser::internal_load(
+		const char *data, size_t length, bool lazy, std::pmr::memory_resource *resource, symbol_table *symbols)
 	{
-		return str.substr(0, find_first_nonescaped(str, ';'));
+		config_builder builder(nullptr, lazy, false, resource, symbols);
+		tokenizer(builder, lazy).process_buffer(data, length);
+		return std::move(builder.finish());
 	}
 
-	std::vector<std::string> parser::parse_option_list(const std::string &str)
+	load_result parser::internal_try_load(std::istream &str)
 	{
-		using namespace string_utils;
-
-		std::string searched = str;
-		std::vector<std::string> result;
-		char delim = ',';
-
-		size_t pos = find_first_nonescaped(searched, ',');
-		if (pos == std::string::npos) {
-			// if no escaped strokes are present in given string,
-			//   try to use colon
-			delim = ':';
-		}
-
-		while (true) {
-			pos = find_first_nonescaped(searched, delim);
-
-			// extract option value and process it
-			std::string value = searched.substr(0, pos);
-			value = left_trim(value);
-			// check if last escaped character is whitespace
-			size_t whitespace_pos = find_last_escaped(value, ' ');
-			value = right_trim(value);
-			if (whitespace_pos != std::string::npos) {
-				// last character is escaped whitespace
-				if (value.size() == whitespace_pos) { value.push_back(' '); }
-			}
-			// finally unescape
-			value = unescape(value);
-
-			// save extracted and processed option value and cut searched string
-			result.push_back(value);
-
-			if (pos == std::string::npos) {
-				// no delimiter found
-				break;
-			}
-			searched = searched.substr(pos + 1);
-		}
-
-		return result;
+		config_builder builder(nullptr, false, true);
+		tokenizer(builder).process_stream(str);
+		config &cfg = builder.finish();
+		if (builder.error()) { return *builder.error(); }
+		return std::move(cfg);
 	}
 
-	void parser::handle_links(
-		const config &cfg, const section &last_section, std::vector<std::string> &option_val_list, size_t line_number)
+	load_result parser::internal_try_load(const char *data, size_t length)
 	{
-		using namespace string_utils;
-
-		for (auto &opt_value : option_val_list) {
-			if (starts_with(opt_value, "${") && ends_with(opt_value, "}")) {
-				std::string link = opt_value.substr(2, opt_value.length() - 3);
-				size_t delim = find_first_nonescaped(link, '#');
-
-				// link always has to be in format "section#option"
-				// section and option cannot be empty
-				if (delim == std::string::npos || (delim + 1) == link.length()) {
-					throw parser_exception("Bad format of link on line " + std::to_string(line_number));
-				}
-
-				std::string sect_link = link.substr(0, delim);
-				std::string opt_link = link.substr(delim + 1);
-
-				if (sect_link.empty()) {
-					throw parser_exception(
-						"Section name in link cannot be empty on line " + std::to_string(line_number));
-				}
-
-				// find section with name specifid in link
-				const section *selected_section = nullptr;
-				if (last_section.get_name() == sect_link) {
-					selected_section = &last_section;
-				} else if (cfg.contains(sect_link)) {
-					selected_section = &cfg[sect_link];
-				} else {
-					throw parser_exception("Bad link on line " + std::to_string(line_number));
-				}
-
-				// from selected section take appropriate option and set its value to options list
-				if (selected_section->contains(opt_link)) {
-					opt_value = selected_section->operator[](opt_link).get<string_ini_t>();
-				} else {
-					throw parser_exception("Option name in link not found on line " + std::to_string(line_number));
-				}
-			}
-		}
+		config_builder builder(nullptr, false, true);
+		tokenizer(builder).process_buffer(data, length);
+		config &cfg = builder.finish();
+		if (builder.error()) { return *builder.error(); }
+		return std::move(cfg);
 	}
 
-	void parser::validate_identifier(const std::string &str, size_t line_number)
+	config parser::internal_load_parallel(const char *data, size_t length, size_t threads)
 	{
-		std::regex reg_expr("^[a-zA-Z.$:][-a-zA-Z0-9_~.:$ ]*$");
-		if (!std::regex_match(str, reg_expr)) {
-			throw parser_exception("Identifier contains forbidden characters on line " + std::to_string(line_number));
+		if (threads == 0) { threads = std::max<size_t>(std::thread::hardware_concurrency(), 1); }
+
+		// split input to chunks which start with section header, few chunks per thread for balancing
+		const size_t min_chunk_size = 64 * 1024;
+		size_t chunk_count = std::min(threads * 4, length / min_chunk_size);
+		std::vector<std::string_view> chunks;
+		size_t chunk_begin = 0;
+		for (size_t i = 1; i < chunk_count; ++i) {
+			size_t pos = std::max(length / chunk_count * i, chunk_begin);
+			std::string_view rest(data + pos, length - pos);
+			size_t header = rest.find("\n[");
+			if (header == std::string_view::npos) { break; }
+
+			size_t chunk_end = pos + header + 1;
+			chunks.emplace_back(data + chunk_begin, chunk_end - chunk_begin);
+			chunk_begin = chunk_end;
 		}
-	}
+		chunks.emplace_back(data + chunk_begin, length - chunk_begin);
+
+		if (threads == 1 || chunks.size() == 1) { return internal_load(data, length); }
+
+		// every chunk is parsed into its own config, links are only recorded
+		struct chunk_result {
+			config cfg;
+			std::vector<deferred_link> links;
+			bool failed = false;
+		};
+		std::vector<chunk_result> results(chunks.size());
+		std::atomic<size_t> next_chunk(0);
+
+		auto worker = [&]() {
+			for (size_t i = next_chunk++; i < chunks.size(); i = next_chunk++) {
+				auto &result = results[i];
+				try {
+					config_builder builder(&result.links);
+					tokenizer(builder).process_buffer(chunks[i].data(), chunks[i].length());
+					result.cfg = std::move(builder.finish());
+				} catch (...) {
+					result.failed = true;
+				}
+			}
+		};
 
-	config parser::internal_load(std::istream &str)
-	{
-		using namespace string_utils;
+		std::vector<std::thread> pool;
+		for (size_t i = 1; i < std::min(threads, chunks.size()); ++i) { pool.emplace_back(worker); }
+		worker();
+		for (auto &thread : pool) { thread.join(); }
 
+		// merge chunks in original order and resolve links against everything defined before them
 		config cfg;
-		std::shared_ptr<section> last_section = nullptr;
-		std::string line;
-		size_t line_number = 0;
-
-		while (std::getline(str, line)) {
-			line_number++;
-
-			// if there was comment delete it
-			line = delete_comment(line);
-			line = left_trim(line);
-
-			if (line.empty()) { // empty line
-				continue;
-			} else if (starts_with(line, "[")) { // start of section
-				line = right_trim(line);
-				if (ends_with(line, "]")) {
-					// empty section name cannot be present
-					if (line.length() == 2) {
-						throw parser_exception("Section name cannot be empty on line " + std::to_string(line_number));
+		try {
+			for (auto &result : results) {
+				if (result.failed) { throw parser_exception("Chunk parsing failed"); }
+
+				auto link = result.links.begin();
+				for (size_t i = 0; i < result.cfg.size(); ++i) {
+					section &sect = result.cfg[i];
+					for (; link != result.links.end() && link->section_index == i; ++link) {
+						option &opt = sect[link->option_index];
+						auto option_val_list = opt.get_list<string_ini_t>();
+						config_builder::handle_links(cfg, sect, option_val_list, link->line_number, link->option_index);
+						opt.set_list(option_val_list);
 					}
-
-					// if there is cached section, save it
-					if (last_section != nullptr) { cfg.add_section(*last_section); }
-
-					// extract name and validate it and finally create section object
-					std::string sect_name = unescape(line.substr(1, line.length() - 2));
-					validate_identifier(sect_name, line_number);
-					last_section = std::make_shared<section>(sect_name);
-				} else {
-					throw parser_exception("Section not ended on line " + std::to_string(line_number));
-				}
-			} else { // option
-				size_t opt_delim = find_first_nonescaped(line, '=');
-				if (opt_delim == std::string::npos) {
-					throw parser_exception("Unknown element option expected on line " + std::to_string(line_number));
-				}
-
-				// if there is no opened section, option has no parent section
-				if (last_section == nullptr) {
-					throw parser_exception("Option not in section on line " + std::to_string(line_number));
-				}
-
-				// equals character was right at the end of line, should not be
-				if ((opt_delim + 1) == line.length()) {
-					throw parser_exception("Option value cannot be empty on line " + std::to_string(line_number));
-				}
-
-				// retrieve option name and value from line
-				std::string option_name = unescape(trim(line.substr(0, opt_delim)));
-				std::string option_val = line.substr(opt_delim + 1);
-
-				// validate option name
-				validate_identifier(option_name, line_number);
-
-				if (option_name.empty()) {
-					throw parser_exception("Option name cannot be empty on line " + std::to_string(line_number));
+					if (cfg.contains(sect.get_name())) { throw ambiguity_exception(sect.get_name()); }
+					cfg.add_section(std::move(sect));
 				}
-
-				auto option_val_list = parse_option_list(option_val);
-				if (option_val_list.empty()) {
-					throw parser_exception("Option value cannot be empty on line " + std::to_string(line_number));
-				}
-
-				handle_links(cfg, *last_section, option_val_list, line_number);
-
-				// and finally create option and store it in current section
-				option opt(option_name, option_val_list);
-				last_section->add_option(opt);
 			}
+		} catch (const exception &) {
+			// input is not valid, sequential parsing reports the same error as parser::load() would
+			return internal_load(data, length);
 		}
 
-		// if there is cached section we have to add it to created config too
-		if (last_section != nullptr) { cfg.add_section(*last_section); }
-
 		return cfg;
 	}
 
@@ -296,14 +249,22 @@ namespace inicpp
 
 	config parser::load(const std::string &str)
 	{
-		std::istringstream input(str);
-		return internal_load(input);
+		return internal_load(str.data(), str.size());
+	}
+
+	config parser::load(const std::string &str, std::pmr::memory_resource *resource)
+	{
+		return internal_load(str.data(), str.size(), false, resource);
+	}
+
+	config parser::load(const std::string &str, symbol_table &symbols)
+	{
+		return internal_load(str.data(), str.size(), false, std::pmr::get_default_resource(), &symbols);
 	}
 
 	config parser::load(const std::string &str, const schema &schm, schema_mode mode)
 	{
-		std::istringstream input(str);
-		config cfg = internal_load(input);
+		config cfg = internal_load(str.data(), str.size());
 		cfg.validate(schm, mode);
 		return cfg;
 	}
@@ -313,6 +274,16 @@ namespace inicpp
 		return internal_load(str);
 	}
 
+	config parser::load(std::istream &str, std::pmr::memory_resource *resource)
+	{
+		return internal_load(str, false, resource);
+	}
+
+	config parser::load(std::istream &str, symbol_table &symbols)
+	{
+		return internal_load(str, false, std::pmr::get_default_resource(), &symbols);
+	}
+
 	config parser::load(std::istream &str, const schema &schm, schema_mode mode)
 	{
 		config cfg = internal_load(str);
@@ -328,6 +299,22 @@ namespace inicpp
 		return internal_load(input);
 	}
 
+	config parser::load_file(const std::string &file, std::pmr::memory_resource *resource)
+	{
+		std::ifstream input(file);
+		if (input.fail()) { throw parser_exception("File reading error"); }
+
+		return internal_load(input, false, resource);
+	}
+
+	config parser::load_file(const std::string &file, symbol_table &symbols)
+	{
+		std::ifstream input(file);
+		if (input.fail()) { throw parser_exception("File reading error"); }
+
+		return internal_load(input, false, std::pmr::get_default_resource(), &symbols);
+	}
+
 	config parser::load_file(const std::string &file, const schema &schm, schema_mode mode)
 	{
 		std::ifstream input(file);
@@ -338,6 +325,142 @@ namespace inicpp
 		return cfg;
 	}
 
+	config parser::load_file_mapped(const std::string &file)
+	{
+#ifdef INICPP_HAS_MMAP
+		mapped_file mapping(file);
+		if (mapping.is_mapped()) { return internal_load(mapping.data(), mapping.size()); }
+#endif
+
+		// mapping is not available or failed, use standard stream
+		return load_file(file);
+	}
+
+	config parser::load_file_mapped(const std::string &file, const schema &schm, schema_mode mode)
+	{
+		config cfg = load_file_mapped(file);
+		cfg.validate(schm, mode);
+		return cfg;
+	}
+
+	config parser::load_parallel(const std::string &str, size_t threads)
+	{
+		return internal_load_parallel(str.data(), str.size(), threads);
+	}
+
+	config parser::load_parallel(const std::string &str, size_t threads, const schema &schm, schema_mode mode)
+	{
+		config cfg = internal_load_parallel(str.data(), str.size(), threads);
+		cfg.validate(schm, mode);
+		return cfg;
+	}
+
+	config parser::load_lazy(const std::string &str)
+	{
+		return internal_load(str.data(), str.size(), true);
+	}
+
+	config parser::load_lazy(std::istream &str)
+	{
+		return internal_load(str, true);
+	}
+
+	config parser::load_file_lazy(const std::string &file)
+	{
+#ifdef INICPP_HAS_MMAP
+		mapped_file mapping(file);
+		if (mapping.is_mapped()) { return internal_load(mapping.data(), mapping.size(), true); }
+#endif
+
+		// mapping is not available or failed, use standard stream
+		std::ifstream input(file);
+		if (input.fail()) { throw parser_exception("File reading error"); }
+
+		return internal_load(input, true);
+	}
+
+	namespace
+	{
+		/**
+		 * Validate loaded config against schema, validation errors are returned in the result.
+		 */
+		load_result validated(load_result result, const schema &schm, schema_mode mode)
+		{
+			if (!result) { return result; }
+
+			try {
+				result->validate(schm, mode);
+			} catch (const exception &e) {
+				// validation is not on the hot path of malformed input, so its exceptions are only translated
+				return load_error(load_error_code::validation_failed, 0, 0, 0, e.what());
+			}
+			return result;
+		}
+	} // namespace
+
+	load_result parser::try_load(const std::string &str)
+	{
+		return internal_try_load(str.data(), str.size());
+	}
+
+	load_result parser::try_load(const std::string &str, const schema &schm, schema_mode mode)
+	{
+		return validated(internal_try_load(str.data(), str.size()), schm, mode);
+	}
+
+	load_result parser::try_load(std::istream &str)
+	{
+		return internal_try_load(str);
+	}
+
+	load_result parser::try_load(std::istream &str, const schema &schm, schema_mode mode)
+	{
+		return validated(internal_try_load(str), schm, mode);
+	}
+
+	load_result parser::try_load_file(const std::string &file)
+	{
+#ifdef INICPP_HAS_MMAP
+		mapped_file mapping(file);
+		if (mapping.is_mapped()) { return internal_try_load(mapping.data(), mapping.size()); }
+#endif
+
+		// mapping is not available or failed, use standard stream
+		std::ifstream input(file);
+		if (input.fail()) { return load_error(load_error_code::file_not_readable, 0, 0, 0); }
+
+		return internal_try_load(input);
+	}
+
+	load_result parser::try_load_file(const std::string &file, const schema &schm, schema_mode mode)
+	{
+		return validated(try_load_file(file), schm, mode);
+	}
+
+	bool parser::parse(const std::string &str, parse_handler &handler)
+	{
+		return tokenizer(handler).process_buffer(str.data(), str.size());
+	}
+
+	bool parser::parse(std::istream &str, parse_handler &handler)
+	{
+		return tokenizer(handler).process_stream(str);
+	}
+
+	bool parser::parse_file(const std::string &file, parse_handler &handler)
+	{
+#ifdef INICPP_HAS_MMAP
+		mapped_file mapping(file);
+		if (mapping.is_mapped()) { return tokenizer(handler).process_buffer(mapping.data(), mapping.size()); }
+#endif
+
+		// mapping is not available or failed, use standard stream
+		std::ifstream input(file);
+		if (input.fail()) { throw parser_exception("File reading error"); }
+
+		return tokenizer(handler).process_stream(input);
+	}
+
 	void parser::save(const config &cfg, const std::string &file)
 	{
 		std::ofstream output(file);
@@ -345,6 +468,14 @@ namespace inicpp
 		output.close();
 	}
 
+	std::string parser::save_to_string(const config &cfg)
+	{
+		serializer writer;
+		writer.reserve(serializer::estimate_size(cfg));
+		writer.write(cfg);
+		return std::move(writer.buffer());
+	}
+
 	void parser::save(const config &cfg, std::ostream &str)
 	{
 		str << cfg;
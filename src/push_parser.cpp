@@ -0,0 +1,89 @@
+#include "push_parser.h"
+#include "config_builder.h"
+#include "tokenizer.h"
+
+#include <cstring>
+
+namespace inicpp
+{
+	push_parser::push_parser()
+		: builder_(std::make_unique<config_builder>()), handler_(builder_.get()), tokenizer_(), pending_(),
+		  stopped_(false)
+	{
+		reset();
+	}
+
+	push_parser::push_parser(parse_handler &handler)
+		: builder_(nullptr), handler_(&handler), tokenizer_(), pending_(), stopped_(false)
+	{
+		reset();
+	}
+
+	push_parser::push_parser(push_parser &&source) = default;
+
+	push_parser &push_parser::operator=(push_parser &&source) = default;
+
+	push_parser::~push_parser()
+	{
+	}
+
+	void push_parser::reset()
+	{
+		if (builder_ != nullptr) {
+			builder_ = std::make_unique<config_builder>();
+			handler_ = builder_.get();
+		}
+		tokenizer_ = std::make_unique<tokenizer>(*handler_);
+		pending_.clear();
+		stopped_ = false;
+	}
+
+	bool push_parser::feed(const char *data, size_t length)
+	{
+		if (stopped_) { return false; }
+
+		const char *end = data + length;
+		if (!pending_.empty()) {
+			// finish line started in previous chunks
+			auto line_end = static_cast<const char *>(std::memchr(data, '\n', length));
+			if (line_end == nullptr) {
+				pending_.append(data, length);
+				return true;
+			}
+
+			pending_.append(data, static_cast<size_t>(line_end - data));
+			stopped_ = !tokenizer_->process_line(pending_);
+			pending_.clear();
+			if (stopped_) { return false; }
+			data = line_end + 1;
+		}
+
+		// complete lines are processed in place, only the unfinished rest is copied
+		std::string_view rest(data, static_cast<size_t>(end - data));
+		size_t last_newline = rest.rfind('\n');
+		if (last_newline != std::string_view::npos) {
+			stopped_ = !tokenizer_->process_buffer(data, last_newline + 1);
+			if (stopped_) { return false; }
+			rest.remove_prefix(last_newline + 1);
+		}
+		pending_.append(rest);
+
+		return true;
+	}
+
+	bool push_parser::feed(std::string_view data)
+	{
+		return feed(data.data(), data.length());
+	}
+
+	config push_parser::finish()
+	{
+		// the last line does not need terminating newline, the same as with std::getline
+		if (!stopped_ && !pending_.empty()) { tokenizer_->process_line(pending_); }
+
+		config result;
+		if (builder_ != nullptr) { result = std::move(builder_->finish()); }
+		reset();
+		return result;
+	}
+} // namespace inicpp
@@ -0,0 +1,211 @@
+#include "scanner.h"
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INICPP_SCANNER_SSE2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define INICPP_SCANNER_AVX2
+#endif
+#endif
+
+namespace inicpp
+{
+	namespace scanner
+	{
+		namespace
+		{
+			/** Characters searched by scanner, order corresponds to structural enum */
+			constexpr char structural_chars[structural_count] = {';', '=', ',', ':', '#'};
+
+			/**
+			 * Raw masks of one block, before escaped characters are removed.
+			 */
+			struct raw_masks {
+				uint64_t chars[structural_count];
+				uint64_t backslash;
+			};
+
+			/** Signature of block classifying function */
+			using classify_fn = void (*)(const char *block, raw_masks &masks);
+
+			void classify_scalar(const char *block, raw_masks &masks)
+			{
+				masks = raw_masks();
+				for (size_t i = 0; i < block_size; ++i) {
+					uint64_t bit = uint64_t(1) << i;
+					for (size_t ch = 0; ch < structural_count; ++ch) {
+						if (block[i] == structural_chars[ch]) { masks.chars[ch] |= bit; }
+					}
+					if (block[i] == '\\') { masks.backslash |= bit; }
+				}
+			}
+
+#ifdef INICPP_SCANNER_SSE2
+			uint64_t compare_sse2(__m128i data, char ch)
+			{
+				return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8(ch))));
+			}
+
+			void classify_sse2(const char *block, raw_masks &masks)
+			{
+				masks = raw_masks();
+				for (size_t part = 0; part < block_size / 16; ++part) {
+					__m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + part * 16));
+					for (size_t ch = 0; ch < structural_count; ++ch) {
+						masks.chars[ch] |= compare_sse2(data, structural_chars[ch]) << (part * 16);
+					}
+					masks.backslash |= compare_sse2(data, '\\') << (part * 16);
+				}
+			}
+#endif
+
+#ifdef INICPP_SCANNER_AVX2
+			__attribute__((target("avx2"))) uint64_t compare_avx2(__m256i data, char ch)
+			{
+				return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(ch))));
+			}
+
+			__attribute__((target("avx2"))) void classify_avx2(const char *block, raw_masks &masks)
+			{
+				__m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+				__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+				for (size_t ch = 0; ch < structural_count; ++ch) {
+					masks.chars[ch] =
+						compare_avx2(low, structural_chars[ch]) | (compare_avx2(high, structural_chars[ch]) << 32);
+				}
+				masks.backslash = compare_avx2(low, '\\') | (compare_avx2(high, '\\') << 32);
+			}
+#endif
+
+			/**
+			 * Select the best classifier supported by running processor.
+			 */
+			classify_fn select_classifier()
+			{
+#ifdef INICPP_SCANNER_AVX2
+				if (__builtin_cpu_supports("avx2")) { return classify_avx2; }
+#endif
+#ifdef INICPP_SCANNER_SSE2
+				return classify_sse2;
+#else
+				return classify_scalar;
+#endif
+			}
+
+			/**
+			 * Number of trailing zero bits in nonzero mask, which is position of first set bit.
+			 */
+			size_t trailing_zeros(uint64_t mask)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return static_cast<size_t>(__builtin_ctzll(mask));
+#elif defined(_MSC_VER) && defined(_M_X64)
+				unsigned long index;
+				_BitScanForward64(&index, mask);
+				return index;
+#else
+				size_t bit = 0;
+				while ((mask & (uint64_t(1) << bit)) == 0) { ++bit; }
+				return bit;
+#endif
+			}
+
+			/**
+			 * Computes mask of characters escaped by backslashes, without branches.
+			 * Escaping backslash is the one which ends odd-length sequence of backslashes.
+			 * @param backslash mask of backslashes in the block
+			 * @param prev_escaped 1 if the first character of the block is escaped,
+			 *   on return contains the same information for the next block
+			 * @return mask of escaped characters
+			 */
+			uint64_t escaped_mask(uint64_t backslash, uint64_t &prev_escaped)
+			{
+				const uint64_t even_bits = 0x5555555555555555ULL;
+
+				// escaped backslash at the beginning cannot escape anything
+				backslash &= ~prev_escaped;
+				uint64_t follows_escape = (backslash << 1) | prev_escaped;
+
+				// sequences starting on odd bits are moved by one bit using addition carries
+				uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+				uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+				prev_escaped = (sequences_starting_on_even_bits < backslash) ? 1 : 0;
+				uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+
+				// every other character after backslash is escaped
+				return (even_bits ^ invert_mask) & follows_escape;
+			}
+		} // namespace
+
+		structural_index::structural_index(std::string_view str)
+			: str_(str), inline_masks_(), heap_masks_(), masks_(inline_masks_), blocks_(0), has_backslash_(false)
+		{
+			static const classify_fn classify = select_classifier();
+
+			blocks_ = (str.length() + block_size - 1) / block_size;
+			block_masks *masks = inline_masks_;
+			if (blocks_ > inline_blocks) {
+				heap_masks_.resize(blocks_);
+				masks = heap_masks_.data();
+				masks_ = masks;
+			}
+
+			uint64_t prev_escaped = 0;
+			raw_masks raw;
+			for (size_t block = 0; block < blocks_; ++block) {
+				size_t offset = block * block_size;
+				if (str.length() - offset >= block_size) {
+					classify(str.data() + offset, raw);
+				} else {
+					// last block is padded with zeroes, which do not match anything
+					char padded[block_size] = {};
+					std::memcpy(padded, str.data() + offset, str.length() - offset);
+					classify(padded, raw);
+				}
+
+				// lines without backslashes do not need any escape handling
+				uint64_t escaped = 0;
+				if (raw.backslash != 0 || prev_escaped != 0) {
+					has_backslash_ = true;
+					escaped = escaped_mask(raw.backslash, prev_escaped);
+				}
+				for (size_t ch = 0; ch < structural_count; ++ch) { masks[block].chars[ch] = raw.chars[ch] & ~escaped; }
+			}
+
+			// keep scalar classifier referenced, it is used on platforms without SSE2
+			(void) classify_scalar;
+		}
+
+		size_t structural_index::find(structural ch, size_t from) const
+		{
+			size_t index = static_cast<size_t>(ch);
+			for (size_t block = from / block_size; block < blocks_; ++block) {
+				uint64_t mask = masks_[block].chars[index];
+				if (block == from / block_size) {
+					// ignore positions before starting position
+					mask &= ~uint64_t(0) << (from % block_size);
+				}
+				if (mask != 0) { return block * block_size + trailing_zeros(mask); }
+			}
+
+			return std::string_view::npos;
+		}
+
+		bool structural_index::has_backslash() const
+		{
+			return has_backslash_;
+		}
+
+		size_t find_first_nonescaped(std::string_view str, structural ch)
+		{
+			return structural_index(str).find(ch);
+		}
+	} // namespace scanner
+} // namespace inicpp
@@ -0,0 +1,91 @@
+#ifndef INICPP_SCANNER_H
+#define INICPP_SCANNER_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace inicpp
+{
+	/**
+	 * Internal namespace with vectorized scanner of ini lines. Line is processed
+	 * in blocks of 64 bytes, for every block bitmasks of all structural characters
+	 * are computed at once and escaped characters are removed from them.
+	 */
+	namespace scanner
+	{
+		/** Characters which have special meaning in ini line, value is index to masks */
+		enum class structural : unsigned { semicolon, equals, comma, colon, hash };
+		/** Number of structural characters */
+		constexpr size_t structural_count = 5;
+		/** Number of bytes covered by one block of masks */
+		constexpr size_t block_size = 64;
+
+		/**
+		 * Masks of one block, bit i corresponds to byte i of the block.
+		 */
+		struct block_masks {
+			/** Nonescaped occurences of each structural character */
+			uint64_t chars[structural_count];
+		};
+
+		/**
+		 * Positions of all nonescaped structural characters in given string.
+		 * Escaping character is '\'. Whole string is scanned once in constructor,
+		 * queries afterwards only walk through precomputed bitmasks.
+		 */
+		class structural_index
+		{
+		private:
+			/** Number of blocks which are stored without heap allocation */
+			static constexpr size_t inline_blocks = 4;
+
+			/** Scanned string */
+			std::string_view str_;
+			/** Masks for short strings */
+			block_masks inline_masks_[inline_blocks];
+			/** Masks for strings longer than inline_blocks * block_size */
+			std::vector<block_masks> heap_masks_;
+			/** Pointer to used masks storage */
+			const block_masks *masks_;
+			/** Number of blocks */
+			size_t blocks_;
+			/** True if there is any backslash in the string */
+			bool has_backslash_;
+
+		public:
+			/**
+			 * Scan given string. String has to outlive this index.
+			 * @param str scanned string
+			 */
+			explicit structural_index(std::string_view str);
+
+			structural_index(const structural_index &) = delete;
+			structural_index &operator=(const structural_index &) = delete;
+
+			/**
+			 * Finds first nonescaped structural character at or after given position.
+			 * @param ch searched structural character
+			 * @param from position in string where search starts
+			 * @return position of the character or std::string_view::npos if not found
+			 */
+			size_t find(structural ch, size_t from = 0) const;
+			/**
+			 * Determines whether scanned string contains backslash.
+			 * @return true if escape handling is needed
+			 */
+			bool has_backslash() const;
+		};
+
+		/**
+		 * Finds first nonescaped character given as parameter.
+		 * Escaping character is '\'.
+		 * @param str searched string
+		 * @param ch searched structural character
+		 * @return std::string_view::npos if not found
+		 */
+		size_t find_first_nonescaped(std::string_view str, structural ch);
+	} // namespace scanner
+} // namespace inicpp
+
+#endif // INICPP_SCANNER_H
@@ -2,18 +2,17 @@
 
 namespace inicpp
 {
-	schema::schema() : sections_(), sections_map_()
+	schema::schema() : sections_(), sections_index_()
 	{
 	}
 
-	schema::schema(const schema &source) : sections_(), sections_map_()
+	schema::schema(const schema &source) : sections_(), sections_index_(source.sections_index_)
 	{
-		// we have to do deep copies of section schemas
+		// we have to do deep copies of section schemas, index of source is valid for them,
+		//   because they are stored on the same positions
 		sections_.reserve(source.sections_.size());
 		for (auto &sect : source.sections_) { sections_.push_back(std::make_shared<section_schema>(*sect)); }
-
-		// we already have constructed section schemas... now push them into map
-		for (auto &sect : sections_) { sections_map_.insert(sect_schema_map_pair(sect->get_name(), sect)); }
+		sect_schema_index::adopt(sections_);
 	}
 
 	schema &schema::operator=(const schema &source)
@@ -26,7 +25,7 @@ namespace inicpp
 		return *this;
 	}
 
-	schema::schema(schema &&source) : sections_(), sections_map_()
+	schema::schema(schema &&source) : sections_(), sections_index_()
 	{
 		*this = std::move(source);
 	}
@@ -35,7 +34,7 @@ namespace inicpp
 	{
 		if (this != &source) {
 			sections_ = std::move(source.sections_);
-			sections_map_ = std::move(source.sections_map_);
+			sections_index_ = std::move(source.sections_index_);
 		}
 
 		return *this;
@@ -43,11 +42,9 @@ namespace inicpp
 
 	void schema::add_section(const section_schema &sect_schema)
 	{
-		auto add_it = sections_map_.find(sect_schema.get_name());
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section_schema> add = std::make_shared<section_schema>(sect_schema);
-			sections_.push_back(add);
-			sections_map_.insert(sect_schema_map_pair(add->get_name(), add));
+		if (sections_index_.find(sect_schema.get_name(), sections_) == sect_schema_index::npos) {
+			sections_.push_back(std::make_shared<section_schema>(sect_schema));
+			sections_index_.push_back(sections_);
 		} else {
 			throw ambiguity_exception(sect_schema.get_name());
 		}
@@ -55,23 +52,21 @@ namespace inicpp
 
 	void schema::add_section(const section_schema_params &arguments)
 	{
-		auto add_it = sections_map_.find(arguments.name);
-		if (add_it == sections_map_.end()) {
-			std::shared_ptr<section_schema> add = std::make_shared<section_schema>(arguments);
-			sections_.push_back(add);
-			sections_map_.insert(sect_schema_map_pair(add->get_name(), add));
+		if (sections_index_.find(arguments.name, sections_) == sect_schema_index::npos) {
+			sections_.push_back(std::make_shared<section_schema>(arguments));
+			sections_index_.push_back(sections_);
 		} else {
 			throw ambiguity_exception(arguments.name);
 		}
 	}
 
-	void schema::add_option(const std::string &section_name, const option_schema &opt_schema)
+	void schema::add_option(std::string_view section_name, const option_schema &opt_schema)
 	{
-		auto sect_it = sections_map_.find(section_name);
-		if (sect_it != sections_map_.end()) {
-			sect_it->second->add_option(opt_schema);
+		size_t sect_pos = sections_index_.find(section_name, sections_);
+		if (sect_pos != sect_schema_index::npos) {
+			sections_[sect_pos]->add_option(opt_schema);
 		} else {
-			throw not_found_exception(section_name);
+			throw not_found_exception(std::string(section_name));
 		}
 	}
 
@@ -94,36 +89,25 @@ namespace inicpp
 		return *sections_[index];
 	}
 
-	section_schema &schema::operator[](const std::string &section_name)
+	section_schema &schema::operator[](std::string_view section_name)
 	{
-		std::shared_ptr<section_schema> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (const std::out_of_range &) {
-			throw not_found_exception(section_name);
-		}
-		return *result;
+		size_t pos = sections_index_.find(section_name, sections_);
+		if (pos == sect_schema_index::npos) { throw not_found_exception(std::string(section_name)); }
+
+		return *sections_[pos];
 	}
 
-	const section_schema &schema::operator[](const std::string &section_name) const
+	const section_schema &schema::operator[](std::string_view section_name) const
 	{
-		std::shared_ptr<section_schema> result;
-		try {
-			result = sections_map_.at(section_name);
-		} catch (const std::out_of_range &) {
-			throw not_found_exception(section_name);
-		}
-		return *result;
+		size_t pos = sections_index_.find(section_name, sections_);
+		if (pos == sect_schema_index::npos) { throw not_found_exception(std::string(section_name)); }
+
+		return *sections_[pos];
 	}
 
-	bool schema::contains(const std::string &section_name) const
+	bool schema::contains(std::string_view section_name) const
 	{
-		try {
-			sections_map_.at(section_name);
-			return true;
-		} catch (const std::out_of_range &) {
-			return false;
-		}
+		return sections_index_.find(section_name, sections_) != sect_schema_index::npos;
 	}
 
 	void schema::validate_config(config &cfg, schema_mode mode) const
@@ -1,78 +1,137 @@
 #include "section.h"
+#include "serializer.h"
+#include "symbol_table.h"
 
 namespace inicpp
 {
-	section::section(const section &source) : options_(), options_map_(), name_(source.name_)
+	section::section(const section &source) : section(source, std::pmr::get_default_resource())
 	{
-		// we have to do deep copies of options
-		options_.reserve(source.options_.size());
-		for (auto &opt : source.options_) { options_.push_back(std::make_shared<option>(*opt)); }
+	}
 
-		// we already have constructed options... now push them into map
-		for (auto &opt : options_) { options_map_.insert(options_map_pair(opt->get_name(), opt)); }
+	section::section(const section &source, std::pmr::memory_resource *resource)
+		: options_(resource), options_index_(source.options_index_, resource), name_(source.name_),
+		  symbol_(source.symbol_)
+	{
+		// we have to do deep copies of options, index of source is valid for them,
+		//   because they are stored on the same positions
+		options_.reserve(source.options_.size());
+		for (auto &opt : source.options_) {
+			options_.push_back(std::allocate_shared<option>(option_allocator(), *opt));
+		}
+		options_index::adopt(options_);
 	}
 
 	section &section::operator=(const section &source)
 	{
 		if (this != &source) {
-			// make copy of input source section and swap it with this
-			section new_src(source);
-			std::swap(*this, new_src);
+			// make copy of input source section in our resource and move it to this
+			operator=(section(source, get_memory_resource()));
 		}
 
 		return *this;
 	}
 
-	section::section(section &&source) : options_(), options_map_(), name_()
+	section::section(section &&source)
+		: options_(std::move(source.options_)), options_index_(std::move(source.options_index_)),
+		  name_(std::move(source.name_)), symbol_(source.symbol_)
 	{
-		operator=(std::move(source));
+	}
+
+	section::section(section &&source, std::pmr::memory_resource *resource)
+		: options_(resource), options_index_(resource), name_(std::move(source.name_)),
+		  symbol_(source.symbol_)
+	{
+		if (*resource == *source.get_memory_resource()) {
+			options_ = std::move(source.options_);
+			options_index_ = std::move(source.options_index_);
+			return;
+		}
+
+		// options are placed into our resource, so they are different objects and index gets new generation
+		options_.reserve(source.options_.size());
+		for (auto &opt : source.options_) {
+			options_.push_back(std::allocate_shared<option>(option_allocator(), std::move(*opt)));
+		}
+		options_index_ = options_index(source.options_index_, resource);
+		options_index::adopt(options_);
+		source.options_.clear();
+		source.options_index_.clear();
 	}
 
 	section &section::operator=(section &&source)
 	{
-		if (this != &source) {
+		if (this == &source) { return *this; }
+
+		if (*get_memory_resource() == *source.get_memory_resource()) {
 			options_ = std::move(source.options_);
-			options_map_ = std::move(source.options_map_);
-			name_ = std::move(source.name_);
+			options_index_ = std::move(source.options_index_);
+			if (!indexed_) {
+				name_ = std::move(source.name_);
+				symbol_ = source.symbol_;
+			}
+		} else {
+			// pointers of source cannot be taken, options are moved into our resource first
+			operator=(section(std::move(source), get_memory_resource()));
 		}
 		return *this;
 	}
 
-	section::section(const std::string &name) : options_(), options_map_(), name_(name)
+	section::section(std::string name) : options_(), options_index_(), name_(std::move(name)), symbol_(nullptr)
+	{
+	}
+
+	section::section(std::string name, std::pmr::memory_resource *resource)
+		: options_(resource), options_index_(resource), name_(std::move(name)), symbol_(nullptr)
+	{
+	}
+
+	std::pmr::memory_resource *section::get_memory_resource() const
 	{
+		return options_.get_allocator().resource();
 	}
 
 	const std::string &section::get_name() const
 	{
-		return name_;
+		return (symbol_ != nullptr ? *symbol_ : name_);
+	}
+
+	void section::intern(symbol_table &symbols)
+	{
+		symbol_ = &symbols.intern(get_name());
+		name_.clear();
+		name_.shrink_to_fit();
+		for (auto &opt : options_) { opt->intern(symbols); }
 	}
 
 	void section::add_option(const option &opt)
 	{
-		auto add_it = options_map_.find(opt.get_name());
-		if (add_it == options_map_.end()) {
-			std::shared_ptr<option> add = std::make_shared<option>(opt);
-			options_.push_back(add);
-			options_map_.insert(options_map_pair(add->get_name(), add));
+		if (options_index_.find(opt.get_name(), options_) == options_index::npos) {
+			options_.push_back(std::allocate_shared<option>(option_allocator(), opt));
+			options_index_.push_back(options_);
 		} else {
 			throw ambiguity_exception(opt.get_name());
 		}
 	}
 
-	void section::remove_option(const std::string &option_name)
+	void section::add_option(option &&opt)
 	{
-		auto del_it = options_map_.find(option_name);
-		if (del_it != options_map_.end()) {
-			// remove from map
-			options_map_.erase(del_it);
-			// remove from vector
-			options_.erase(
-				std::remove_if(options_.begin(),
-					options_.end(),
-					[&](std::shared_ptr<option> opt) { return (opt->get_name() == option_name ? true : false); }),
-				options_.end());
+		if (options_index_.find(opt.get_name(), options_) == options_index::npos) {
+			options_.push_back(std::allocate_shared<option>(option_allocator(), std::move(opt)));
+			options_index_.push_back(options_);
 		} else {
-			throw not_found_exception(option_name);
+			throw ambiguity_exception(opt.get_name());
+		}
+	}
+
+	void section::remove_option(std::string_view option_name)
+	{
+		size_t del_pos = options_index_.find(option_name, options_);
+		if (del_pos != options_index::npos) {
+			// remove from vector, positions of following options are shifted, so index is built again
+			options_.erase(options_.begin() + static_cast<std::ptrdiff_t>(del_pos));
+			options_index_.rebuild(options_);
+		} else {
+			throw not_found_exception(std::string(option_name));
 		}
 	}
 
@@ -95,36 +154,37 @@ namespace inicpp
 		return *options_[index];
 	}
 
-	option &section::operator[](const std::string &option_name)
+	option &section::operator[](std::string_view option_name)
 	{
-		std::shared_ptr<option> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (const std::out_of_range &) {
-			throw not_found_exception(option_name);
-		}
-		return *result;
+		size_t pos = options_index_.find(option_name, options_);
+		if (pos == options_index::npos) { throw not_found_exception(std::string(option_name)); }
+
+		return *options_[pos];
 	}
 
-	const option &section::operator[](const std::string &option_name) const
+	const option &section::operator[](std::string_view option_name) const
 	{
-		std::shared_ptr<option> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (const std::out_of_range &) {
-			throw not_found_exception(option_name);
-		}
-		return *result;
+		size_t pos = options_index_.find(option_name, options_);
+		if (pos == options_index::npos) { throw not_found_exception(std::string(option_name)); }
+
+		return *options_[pos];
 	}
 
-	bool section::contains(const std::string &option_name) const
+	bool section::contains(std::string_view option_name) const
 	{
-		try {
-			options_map_.at(option_name);
-			return true;
-		} catch (const std::out_of_range &) {
-			return false;
-		}
+		return options_index_.find(option_name, options_) != options_index::npos;
+	}
+
+	option *section::find(std::string_view option_name)
+	{
+		size_t pos = options_index_.find(option_name, options_);
+		return (pos == options_index::npos ? nullptr : options_[pos].get());
+	}
+
+	const option *section::find(std::string_view option_name) const
+	{
+		size_t pos = options_index_.find(option_name, options_);
+		return (pos == options_index::npos ? nullptr : options_[pos].get());
 	}
 
 	void section::validate(const section_schema &sect_schema, schema_mode mode)
@@ -134,7 +194,8 @@ namespace inicpp
 
 	bool section::operator==(const section &other) const
 	{
-		if (name_ != other.name_) { return false; }
+		// interned names are equal if they are the same symbol
+		if (&get_name() != &other.get_name() && get_name() != other.get_name()) { return false; }
 
 		return std::equal(options_.begin(),
 			options_.end(),
@@ -181,9 +242,9 @@ namespace inicpp
 
 	std::ostream &operator<<(std::ostream &os, const section &sect)
 	{
-		os << "[" << sect.get_name() << "]" << std::endl;
-		for (auto &opt : sect.options_) { os << *opt; }
-
+		serializer writer(&os);
+		writer.write(sect);
+		writer.flush();
 		return os;
 	}
 } // namespace inicpp
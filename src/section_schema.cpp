@@ -4,28 +4,25 @@
 namespace inicpp
 {
 	section_schema::section_schema(const section_schema &source)
-		: name_(source.name_), requirement_(source.requirement_), comment_(source.comment_), options_(), options_map_()
+		: name_(source.name_), requirement_(source.requirement_), comment_(source.comment_), options_(),
+		  options_index_(source.options_index_)
 	{
-		// we have to do deep copies of option schemas
+		// we have to do deep copies of option schemas, index of source is valid for them,
+		//   because they are stored on the same positions
 		options_.reserve(source.options_.size());
 		for (auto &opt : source.options_) { options_.push_back(std::make_shared<option_schema>(*opt)); }
-
-		// we already have constructed option schemas... now push them into map
-		for (auto &opt : options_) { options_map_.insert(opt_schema_map_pair(opt->get_name(), opt)); }
+		opt_schema_index::adopt(options_);
 	}
 
 	section_schema &section_schema::operator=(const section_schema &source)
 	{
-		if (this != &source) {
-			section_schema new_src(source);
-			std::swap(*this, new_src);
-		}
+		if (this != &source) { operator=(section_schema(source)); }
 
 		return *this;
 	}
 
 	section_schema::section_schema(section_schema &&source)
-		: name_(), requirement_(), comment_(), options_(), options_map_()
+		: name_(), requirement_(), comment_(), options_(), options_index_()
 	{
 		*this = std::move(source);
 	}
@@ -33,11 +30,11 @@ namespace inicpp
 	section_schema &section_schema::operator=(section_schema &&source)
 	{
 		if (this != &source) {
-			name_ = std::move(source.name_);
+			if (!indexed_) { name_ = std::move(source.name_); }
 			requirement_ = std::move(source.requirement_);
 			comment_ = std::move(source.comment_);
 			options_ = std::move(source.options_);
-			options_map_ = std::move(source.options_map_);
+			options_index_ = std::move(source.options_index_);
 		}
 
 		return *this;
@@ -45,7 +42,7 @@ namespace inicpp
 
 	section_schema::section_schema(const section_schema_params &arguments)
 		: name_(arguments.name), requirement_(arguments.requirement), comment_(arguments.comment), options_(),
-		  options_map_()
+		  options_index_()
 	{
 	}
 
@@ -66,31 +63,23 @@ namespace inicpp
 
 	void section_schema::add_option(const option_schema &opt)
 	{
-		auto add_it = options_map_.find(opt.get_name());
-		if (add_it == options_map_.end()) {
-			std::shared_ptr<option_schema> add = std::make_shared<option_schema>(opt);
-			options_.push_back(add);
-			options_map_.insert(opt_schema_map_pair(add->get_name(), add));
+		if (options_index_.find(opt.get_name(), options_) == opt_schema_index::npos) {
+			options_.push_back(std::make_shared<option_schema>(opt));
+			options_index_.push_back(options_);
 		} else {
 			throw ambiguity_exception(opt.get_name());
 		}
 	}
 
-	void section_schema::remove_option(const std::string &option_name)
+	void section_schema::remove_option(std::string_view option_name)
 	{
-		auto del_it = options_map_.find(option_name);
-		if (del_it != options_map_.end()) {
-			// remove from map
-			options_map_.erase(del_it);
-			// remove from vector
-			options_.erase(std::remove_if(options_.begin(),
-							   options_.end(),
-							   [&](std::shared_ptr<option_schema> opt) {
-								   return (opt->get_name() == option_name ? true : false);
-							   }),
-				options_.end());
+		size_t del_pos = options_index_.find(option_name, options_);
+		if (del_pos != opt_schema_index::npos) {
+			// remove from vector, positions of following options are shifted, so index is built again
+			options_.erase(options_.begin() + static_cast<std::ptrdiff_t>(del_pos));
+			options_index_.rebuild(options_);
 		} else {
-			throw not_found_exception(option_name);
+			throw not_found_exception(std::string(option_name));
 		}
 	}
 
@@ -113,32 +102,24 @@ namespace inicpp
 		return *options_[index];
 	}
 
-	option_schema &section_schema::operator[](const std::string &option_name)
+	option_schema &section_schema::operator[](std::string_view option_name)
 	{
 		// its not pretty but the code is not copy pasted
 		// TODO: solve if it will be used or not
 		return const_cast<option_schema &>(static_cast<const section_schema *>(this)->operator[](option_name));
 	}
 
-	const option_schema &section_schema::operator[](const std::string &option_name) const
+	const option_schema &section_schema::operator[](std::string_view option_name) const
 	{
-		std::shared_ptr<option_schema> result;
-		try {
-			result = options_map_.at(option_name);
-		} catch (const std::out_of_range &) {
-			throw not_found_exception(option_name);
-		}
-		return *result;
+		size_t pos = options_index_.find(option_name, options_);
+		if (pos == opt_schema_index::npos) { throw not_found_exception(std::string(option_name)); }
+
+		return *options_[pos];
 	}
 
-	bool section_schema::contains(const std::string &option_name) const
+	bool section_schema::contains(std::string_view option_name) const
 	{
-		try {
-			options_map_.at(option_name);
-			return true;
-		} catch (const std::out_of_range &) {
-			return false;
-		}
+		return options_index_.find(option_name, options_) != opt_schema_index::npos;
 	}
 
 	void section_schema::validate_section(section &sect, schema_mode mode) const
@@ -189,18 +170,18 @@ namespace inicpp
 	{
 		// write comment
 		auto comment_lines = string_utils::split(get_comment(), '\n');
-		for (auto &comment_line : comment_lines) { os << ";" << comment_line << std::endl; }
+		for (auto &comment_line : comment_lines) { os << ";" << comment_line << '\n'; }
 
 		// optional/mandatory
 		std::string info_line = is_mandatory() ? "mandatory" : "optional";
-		os << ";<" << info_line << ">" << std::endl;
+		os << ";<" << info_line << ">" << '\n';
 
 		return os;
 	}
 
 	std::ostream &section_schema::write_section_name(std::ostream &os) const
 	{
-		os << "[" << get_name() << "]" << std::endl;
+		os << "[" << get_name() << "]" << '\n';
 		return os;
 	}
 
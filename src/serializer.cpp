@@ -0,0 +1,89 @@
+#include "serializer.h"
+#include "string_utils.h"
+
+namespace inicpp
+{
+	serializer::serializer(std::ostream *sink) : buffer_(), sink_(sink)
+	{
+	}
+
+	void serializer::flush_if_full()
+	{
+		if (sink_ != nullptr && buffer_.size() >= flush_size) { flush(); }
+	}
+
+	void serializer::write(const option &opt)
+	{
+		opt.materialize();
+
+		buffer_.append(opt.get_name());
+		buffer_.append(" = ");
+		const value_list &values = opt.values_;
+		bool textual = values.holds<string_ini_t>();
+		for (size_t i = 0; i < values.size(); ++i) {
+			if (i > 0) { buffer_.push_back(','); }
+			if (textual) {
+				string_utils::append_escaped(buffer_, values.string_at(i));
+			} else {
+				string_utils::append_value(buffer_, values[i]);
+			}
+		}
+		buffer_.push_back('\n');
+
+		flush_if_full();
+	}
+
+	void serializer::write(const section &sect)
+	{
+		buffer_.push_back('[');
+		buffer_.append(sect.get_name());
+		buffer_.append("]\n");
+		for (const auto &opt : sect) { write(opt); }
+	}
+
+	void serializer::write(const config &cfg)
+	{
+		for (const auto &sect : cfg) { write(sect); }
+	}
+
+	void serializer::flush()
+	{
+		if (sink_ != nullptr && !buffer_.empty()) {
+			sink_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+			buffer_.clear();
+		}
+	}
+
+	void serializer::reserve(size_t size)
+	{
+		buffer_.reserve(size);
+	}
+
+	std::string &serializer::buffer()
+	{
+		return buffer_;
+	}
+
+	size_t serializer::estimate_size(const config &cfg)
+	{
+		// numbers are estimated by their usual length, strings by their exact length
+		const size_t number_size = 8;
+
+		size_t size = 0;
+		for (const auto &sect : cfg) {
+			size += sect.get_name().length() + 3;
+			for (const auto &opt : sect) {
+				size += opt.get_name().length() + 4;
+				// values are parsed for writing anyway, concurrent reader could replace raw value under our hands
+				opt.materialize();
+				if (opt.values_.holds<string_ini_t>()) {
+					for (size_t i = 0; i < opt.values_.size(); ++i) { size += opt.values_.string_at(i).length() + 1; }
+				} else {
+					size += number_size * opt.values_.size();
+				}
+			}
+		}
+
+		return size;
+	}
+} // namespace inicpp
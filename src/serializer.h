@@ -0,0 +1,80 @@
+#ifndef INICPP_SERIALIZER_H
+#define INICPP_SERIALIZER_H
+
+#include <ostream>
+#include <string>
+
+#include "config.h"
+#include "option.h"
+#include "section.h"
+
+namespace inicpp
+{
+	/**
+	 * Internal writer of ini configuration. Text is written into growable
+	 * character buffer, values are formatted directly from options without
+	 * intermediate copies. If output stream is given, buffer is written
+	 * to it in large blocks, otherwise it holds the whole output.
+	 */
+	class serializer
+	{
+	private:
+		/** Size of buffer after which it is written to the output stream */
+		static constexpr size_t flush_size = 64 * 1024;
+
+		/** Written text which was not flushed yet */
+		std::string buffer_;
+		/** Output stream, nullptr if text is only collected in the buffer */
+		std::ostream *sink_;
+
+		/**
+		 * Write the buffer to the output stream if it is large enough.
+		 */
+		void flush_if_full();
+
+	public:
+		/**
+		 * Construct serializer.
+		 * @param sink output stream, if nullptr whole output is kept in the buffer
+		 */
+		explicit serializer(std::ostream *sink = nullptr);
+
+		serializer(const serializer &) = delete;
+		serializer &operator=(const serializer &) = delete;
+
+		/**
+		 * Write option as one line with its name and values.
+		 */
+		void write(const option &opt);
+		/**
+		 * Write section header followed by all its options.
+		 */
+		void write(const section &sect);
+		/**
+		 * Write all sections of given config.
+		 */
+		void write(const config &cfg);
+		/**
+		 * Write content of the buffer to the output stream.
+		 */
+		void flush();
+		/**
+		 * Reserve space in the buffer.
+		 * @param size expected size of the output
+		 */
+		void reserve(size_t size);
+		/**
+		 * Access text which was written and not flushed.
+		 */
+		std::string &buffer();
+
+		/**
+		 * Estimate size of given config written to ini format, no value is formatted.
+		 * @param cfg estimated config
+		 * @return approximate length of the text
+		 */
+		static size_t estimate_size(const config &cfg);
+	};
+} // namespace inicpp
+
+#endif // INICPP_SERIALIZER_H
@@ -1,31 +1,73 @@
 #include "string_utils.h"
 #include "exception.h"
 #include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <string>
 
 namespace inicpp
 {
 	namespace string_utils
 	{
+		namespace
+		{
+			/** std::isspace wrapper which is safe for chars with highest bit set */
+			bool is_space(char c)
+			{
+				return std::isspace(static_cast<unsigned char>(c)) != 0;
+			}
+		} // namespace
+
 		std::string left_trim(const std::string &str)
 		{
-			auto front = std::find_if(str.begin(), str.end(), [](int c) { return !std::isspace(c); });
-			return std::string(front, str.end());
+			return std::string(left_trim(std::string_view(str)));
+		}
+
+		std::string left_trim(const char *str)
+		{
+			return std::string(left_trim(std::string_view(str)));
+		}
+
+		std::string_view left_trim(std::string_view str)
+		{
+			size_t front = 0;
+			while (front < str.length() && is_space(str[front])) { ++front; }
+			return str.substr(front);
 		}
 
 		std::string right_trim(const std::string &str)
 		{
-			auto back = std::find_if(str.rbegin(), str.rend(), [](int c) { return !std::isspace(c); }).base();
-			return std::string(str.begin(), back);
+			return std::string(right_trim(std::string_view(str)));
+		}
+
+		std::string right_trim(const char *str)
+		{
+			return std::string(right_trim(std::string_view(str)));
+		}
+
+		std::string_view right_trim(std::string_view str)
+		{
+			size_t back = str.length();
+			while (back > 0 && is_space(str[back - 1])) { --back; }
+			return str.substr(0, back);
 		}
 
 		std::string trim(const std::string &str)
 		{
-			auto front = std::find_if(str.begin(), str.end(), [](int c) { return !std::isspace(c); });
-			auto back = std::find_if(str.rbegin(), str.rend(), [](int c) { return !std::isspace(c); }).base();
+			return std::string(trim(std::string_view(str)));
+		}
+
+		std::string trim(const char *str)
+		{
+			return std::string(trim(std::string_view(str)));
+		}
 
-			if (back <= front) { return ""; }
-			return std::string(front, back);
+		std::string_view trim(std::string_view str)
+		{
+			return right_trim(left_trim(str));
 		}
 
 		bool find_needle(const std::string &haystack, const std::string &needle)
@@ -33,30 +75,50 @@ namespace inicpp
 			return (haystack.find(needle) == std::string::npos ? false : true);
 		}
 
-		bool starts_with(const std::string &str, const std::string &search_str)
+		bool starts_with(std::string_view str, std::string_view search_str)
 		{
-			size_t search_str_length = search_str.length();
-
-			if (search_str_length > str.length()) { return false; }
-
-			for (size_t i = 0; i < search_str_length; ++i) {
-				if (str[i] != search_str[i]) { return false; }
-			}
+			if (search_str.length() > str.length()) { return false; }
+			return str.compare(0, search_str.length(), search_str) == 0;
+		}
 
-			return true;
+		bool ends_with(std::string_view str, std::string_view search_str)
+		{
+			if (search_str.length() > str.length()) { return false; }
+			return str.compare(str.length() - search_str.length(), search_str.length(), search_str) == 0;
 		}
 
-		bool ends_with(const std::string &str, const std::string &search_str)
+		namespace
 		{
-			size_t search_str_length = search_str.length();
-			size_t str_length = str.length();
+			/** Character can be first character of identifier */
+			constexpr uint8_t identifier_first = 1;
+			/** Character can be in identifier after the first character */
+			constexpr uint8_t identifier_rest = 2;
 
-			if (search_str_length > str.length()) { return false; }
+			/** Table of character classes of identifiers, indexed by unsigned character value */
+			struct identifier_table {
+				uint8_t classes[256] = {};
 
-			for (size_t i = 0; i < search_str_length; ++i) {
-				if (str[str_length - i - 1] != search_str[search_str_length - i - 1]) { return false; }
-			}
+				constexpr identifier_table()
+				{
+					for (int ch = 'a'; ch <= 'z'; ++ch) { classes[ch] = identifier_first | identifier_rest; }
+					for (int ch = 'A'; ch <= 'Z'; ++ch) { classes[ch] = identifier_first | identifier_rest; }
+					for (int ch = '0'; ch <= '9'; ++ch) { classes[ch] = identifier_rest; }
+					for (unsigned char ch : {'.', '$', ':'}) { classes[ch] = identifier_first | identifier_rest; }
+					for (unsigned char ch : {'-', '_', '~', ' '}) { classes[ch] = identifier_rest; }
+				}
+			};
+
+			constexpr identifier_table identifier_classes;
+		} // namespace
+
+		bool is_valid_identifier(std::string_view str)
+		{
+			if (str.empty()) { return false; }
+			if (!(identifier_classes.classes[static_cast<unsigned char>(str[0])] & identifier_first)) { return false; }
 
+			for (char ch : str.substr(1)) {
+				if (!(identifier_classes.classes[static_cast<unsigned char>(ch)] & identifier_rest)) { return false; }
+			}
 			return true;
 		}
 
@@ -70,73 +132,315 @@ namespace inicpp
 			return result;
 		}
 
-
-		template <> string_ini_t parse_string<string_ini_t>(const std::string &value, const std::string &)
-		{
-			return value;
-		}
-		template <> boolean_ini_t parse_string<boolean_ini_t>(const std::string &value, const std::string &option_name)
+		void append_escaped(std::string &result, std::string_view str)
 		{
-			if (value == "0" || value == "f" || value == "n" || value == "off" || value == "no" ||
-				value == "disabled") {
-				return false;
-			} else if (value == "1" || value == "t" || value == "y" || value == "on" || value == "yes" ||
-				value == "enabled") {
-				return true;
+			// whitespace at both ends would be trimmed by parser, so it is escaped
+			size_t length = str.length();
+			if (length > 0 && is_space(str[0])) { result.push_back('\\'); }
+			if (length > 1 && is_space(str[length - 1])) {
+				result.append(str.substr(0, length - 1));
+				result.push_back('\\');
+				result.push_back(str[length - 1]);
 			} else {
-				throw invalid_type_exception(
-					"Option '" + option_name + "' parsing failed: String '" + value + "' is not valid boolean type.");
+				result.append(str);
 			}
 		}
 
-		template <> enum_ini_t parse_string<enum_ini_t>(const std::string &value, const std::string &)
+		void append_value(std::string &result, const option_value &value)
 		{
-			return enum_ini_t(value);
+			char buffer[32];
+			std::to_chars_result written{buffer, std::errc()};
+			std::visit(overloaded{[&](boolean_ini_t x) { result.append(x ? "yes" : "no"); },
+						   [&](const enum_ini_t &x) { append_escaped(result, static_cast<std::string>(x)); },
+						   [&](float_ini_t x) { written = std::to_chars(buffer, buffer + sizeof(buffer), x); },
+						   [&](signed_ini_t x) { written = std::to_chars(buffer, buffer + sizeof(buffer), x); },
+						   [&](unsigned_ini_t x) { written = std::to_chars(buffer, buffer + sizeof(buffer), x); },
+						   [&](const string_ini_t &x) { append_escaped(result, x); }},
+				value);
+			result.append(buffer, static_cast<size_t>(written.ptr - buffer));
 		}
 
-		template <> float_ini_t parse_string<float_ini_t>(const std::string &value, const std::string &option_name)
+		namespace
 		{
-			try {
-				return std::stod(value);
-			} catch (std::exception &e) {
-				throw invalid_type_exception("Option '" + option_name + "' parsing failed: " + e.what());
+			/** Outcome of number parsing, reported without exceptions */
+			enum class number_status { ok, invalid, out_of_range };
+
+			/** Whitespace skipped before numbers, the same set as in "C" locale */
+			bool is_c_space(char c)
+			{
+				return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
 			}
-		}
 
-		template <> signed_ini_t parse_string<signed_ini_t>(const std::string &value, const std::string &option_name)
-		{
-			try {
-				std::string binary_prefix = "0b";
-				if (value.size() > binary_prefix.size() && 
-				    	std::equal(binary_prefix.begin(), binary_prefix.end(), value.begin())) {
+			bool is_hex_digit(char c)
+			{
+				return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+			}
+
+			/**
+			 * Skips leading whitespace and sign, in the same way as strtoll() and strtod() does.
+			 * @param it position in parsed string, moved behind the sign
+			 * @param end end of parsed string
+			 * @return true if number is negative
+			 */
+			bool skip_space_and_sign(const char *&it, const char *end)
+			{
+				while (it != end && is_c_space(*it)) { ++it; }
+				bool negative = false;
+				if (it != end && (*it == '+' || *it == '-')) {
+					negative = (*it == '-');
+					++it;
+				}
+				return negative;
+			}
+
+			/**
+			 * Parses integer the same way as strtoull(), trailing characters are ignored.
+			 * @param str parsed string
+			 * @param base base of the number, 0 detects octal and hexadecimal prefix
+			 * @param magnitude absolute value of the number
+			 * @param negative true if number has minus sign
+			 * @return status of parsing
+			 */
+			number_status parse_integer(std::string_view str, int base, uint64_t &magnitude, bool &negative)
+			{
+				const char *it = str.data();
+				const char *end = it + str.length();
+				negative = skip_space_and_sign(it, end);
+
+				if (base == 0) {
+					if (end - it > 2 && it[0] == '0' && (it[1] == 'x' || it[1] == 'X') && is_hex_digit(it[2])) {
+						base = 16;
+						it += 2;
+					} else if (it != end && *it == '0') {
+						base = 8;
+					} else {
+						base = 10;
+					}
+				}
+
+				auto [ptr, error] = std::from_chars(it, end, magnitude, base);
+				(void) ptr;
+				if (error == std::errc::invalid_argument) { return number_status::invalid; }
+				if (error == std::errc::result_out_of_range) { return number_status::out_of_range; }
+				return number_status::ok;
+			}
+
+			/**
+			 * Parses integer in format accepted by inicpp, which are the formats of strtoull()
+			 * with automatic base and binary numbers with "0b" prefix.
+			 */
+			number_status parse_ini_integer(std::string_view str, uint64_t &magnitude, bool &negative)
+			{
+				if (str.length() > 2 && str[0] == '0' && str[1] == 'b') {
 					// this is binary number
-					return std::stoll(value.substr(2), 0, 2);
+					return parse_integer(str.substr(2), 2, magnitude, negative);
+				}
+				// decimal, octal and hexadecimal number
+				return parse_integer(str, 0, magnitude, negative);
+			}
+
+			number_status parse_signed(std::string_view str, signed_ini_t &result)
+			{
+				uint64_t magnitude;
+				bool negative;
+				number_status status = parse_ini_integer(str, magnitude, negative);
+				if (status != number_status::ok) { return status; }
+
+				const uint64_t max = static_cast<uint64_t>(std::numeric_limits<signed_ini_t>::max());
+				if (magnitude > max + (negative ? 1 : 0)) { return number_status::out_of_range; }
+				if (negative && magnitude != 0) {
+					result = -static_cast<signed_ini_t>(magnitude - 1) - 1;
 				} else {
-					// decimal and hexadecimal number can handle stoll itself
-					return std::stoll(value, 0, 0);
+					result = static_cast<signed_ini_t>(magnitude);
 				}
-			} catch (std::exception &e) {
-				throw invalid_type_exception("Option '" + option_name + "' parsing failed: " + e.what());
+				return number_status::ok;
 			}
+
+			number_status parse_unsigned(std::string_view str, unsigned_ini_t &result)
+			{
+				uint64_t magnitude;
+				bool negative;
+				number_status status = parse_ini_integer(str, magnitude, negative);
+				if (status != number_status::ok) { return status; }
+
+				// negative numbers wrap around, the same as in strtoull()
+				result = negative ? 0 - magnitude : magnitude;
+				return number_status::ok;
+			}
+
+			/**
+			 * Parses floating point number the same way as strtod() in "C" locale does,
+			 * trailing characters are ignored.
+			 */
+			number_status parse_float(std::string_view str, float_ini_t &result)
+			{
+				const char *it = str.data();
+				const char *end = it + str.length();
+				bool negative = skip_space_and_sign(it, end);
+				if (it != end && (*it == '+' || *it == '-')) {
+					// only one sign is allowed, but std::from_chars would accept another minus
+					return number_status::invalid;
+				}
+
+				float_ini_t value;
+				std::from_chars_result parsed;
+				if (end - it > 3 && it[3] == '(' && (it[0] | 0x20) == 'n' && (it[1] | 0x20) == 'a' &&
+					(it[2] | 0x20) == 'n') {
+					// payload of NaN is not handled by std::from_chars, this rare format is left to strtod
+					std::string nan(it, end);
+					value = std::strtod(nan.c_str(), nullptr);
+					parsed.ec = std::errc();
+				} else if (end - it > 1 && it[0] == '0' && (it[1] == 'x' || it[1] == 'X')) {
+					// std::from_chars would accept another sign after the prefix
+					bool has_digits = end - it > 2 && it[2] != '+' && it[2] != '-';
+					if (has_digits) { parsed = std::from_chars(it + 2, end, value, std::chars_format::hex); }
+					if (!has_digits || parsed.ec == std::errc::invalid_argument) {
+						// prefix without hexadecimal digits, only the zero is parsed
+						value = 0.0;
+						parsed.ec = std::errc();
+					}
+				} else {
+					parsed = std::from_chars(it, end, value, std::chars_format::general);
+				}
+
+				if (parsed.ec == std::errc::invalid_argument) { return number_status::invalid; }
+				if (parsed.ec == std::errc::result_out_of_range) { return number_status::out_of_range; }
+				if (value != 0.0 && std::fabs(value) < std::numeric_limits<float_ini_t>::min()) {
+					// strtod reports inexact denormalized results as out of range, this rare case is left to it
+					std::string denormal(str);
+					errno = 0;
+					float_ini_t checked = std::strtod(denormal.c_str(), nullptr);
+					if (errno == ERANGE) { return number_status::out_of_range; }
+					result = checked;
+					return number_status::ok;
+				}
+
+				result = negative ? -value : value;
+				return number_status::ok;
+			}
+
+			/**
+			 * Converts failed parsing status to exception. Messages of the exceptions
+			 * are the same as the ones produced by standard conversion functions.
+			 * @param function name of standard function with the same behaviour
+			 */
+			[[noreturn]] void throw_parse_error(std::string_view option_name, const char *function)
+			{
+				throw invalid_type_exception("Option '" + std::string(option_name) + "' parsing failed: " + function);
+			}
+		} // namespace
+
+		template <> string_ini_t parse_string<string_ini_t>(std::string_view value, std::string_view)
+		{
+			return string_ini_t(value);
+		}
+
+		template <> boolean_ini_t parse_string<boolean_ini_t>(std::string_view value, std::string_view option_name)
+		{
+			boolean_ini_t result;
+			if (!try_parse_string(value, result)) {
+				throw invalid_type_exception("Option '" + std::string(option_name) + "' parsing failed: String '" +
+					std::string(value) + "' is not valid boolean type.");
+			}
+			return result;
+		}
+
+		template <> enum_ini_t parse_string<enum_ini_t>(std::string_view value, std::string_view)
+		{
+			return enum_ini_t(std::string(value));
+		}
+
+		template <> float_ini_t parse_string<float_ini_t>(std::string_view value, std::string_view option_name)
+		{
+			float_ini_t result = 0.0;
+			if (parse_float(value, result) != number_status::ok) { throw_parse_error(option_name, "stod"); }
+			return result;
+		}
+
+		template <> signed_ini_t parse_string<signed_ini_t>(std::string_view value, std::string_view option_name)
+		{
+			signed_ini_t result = 0;
+			if (parse_signed(value, result) != number_status::ok) { throw_parse_error(option_name, "stoll"); }
+			return result;
 		}
 
 		template <>
-		unsigned_ini_t parse_string<unsigned_ini_t>(const std::string &value, const std::string &option_name)
+		unsigned_ini_t parse_string<unsigned_ini_t>(std::string_view value, std::string_view option_name)
 		{
-			try {
-				std::string binary_prefix = "0b";
-				if (value.size() > binary_prefix.size() &&
-					std::equal(binary_prefix.begin(), binary_prefix.end(), value.begin())) {
-					// this is binary number
-					return std::stoull(value.substr(2), 0, 2);
-				} else {
-					// decimal and hexadecimal number can handle stoull itself
-					return std::stoull(value, 0, 0);
+			unsigned_ini_t result = 0;
+			if (parse_unsigned(value, result) != number_status::ok) { throw_parse_error(option_name, "stoull"); }
+			return result;
+		}
+
+		template <> bool try_parse_string<string_ini_t>(std::string_view value, string_ini_t &result)
+		{
+			result = value;
+			return true;
+		}
+
+		template <> bool try_parse_string<boolean_ini_t>(std::string_view value, boolean_ini_t &result)
+		{
+			// every accepted string has different length or first character
+			switch (value.length()) {
+			case 1:
+				if (value[0] == '0' || value[0] == 'f' || value[0] == 'n') {
+					result = false;
+					return true;
+				}
+				if (value[0] == '1' || value[0] == 't' || value[0] == 'y') {
+					result = true;
+					return true;
+				}
+				return false;
+			case 2:
+				if (value == "no" || value == "on") {
+					result = (value[1] == 'n');
+					return true;
 				}
-			} catch (std::exception &e) {
-				throw invalid_type_exception("Option '" + option_name + "' parsing failed: " + e.what());
+				return false;
+			case 3:
+				if (value == "off" || value == "yes") {
+					result = (value[0] == 'y');
+					return true;
+				}
+				return false;
+			case 7:
+				if (value == "enabled") {
+					result = true;
+					return true;
+				}
+				return false;
+			case 8:
+				if (value == "disabled") {
+					result = false;
+					return true;
+				}
+				return false;
+			default:
+				return false;
 			}
 		}
+
+		template <> bool try_parse_string<enum_ini_t>(std::string_view value, enum_ini_t &result)
+		{
+			result = enum_ini_t(std::string(value));
+			return true;
+		}
+
+		template <> bool try_parse_string<float_ini_t>(std::string_view value, float_ini_t &result)
+		{
+			return parse_float(value, result) == number_status::ok;
+		}
+
+		template <> bool try_parse_string<signed_ini_t>(std::string_view value, signed_ini_t &result)
+		{
+			return parse_signed(value, result) == number_status::ok;
+		}
+
+		template <> bool try_parse_string<unsigned_ini_t>(std::string_view value, unsigned_ini_t &result)
+		{
+			return parse_unsigned(value, result) == number_status::ok;
+		}
 	} // namespace string_utils
 
 	namespace inistd
@@ -0,0 +1,51 @@
+#include "symbol_table.h"
+
+#include <mutex>
+
+namespace inicpp
+{
+	symbol_table::symbol_table() : symbols_(), index_(), mutex_(), bytes_saved_(0)
+	{
+	}
+
+	void symbol_table::count_saved(std::string_view text)
+	{
+		// strings up to the capacity of empty string are stored inside of it without allocation
+		static const size_t inline_capacity = std::string().capacity();
+		if (text.size() > inline_capacity) { bytes_saved_.fetch_add(text.size() + 1, std::memory_order_relaxed); }
+	}
+
+	const std::string &symbol_table::intern(std::string_view text)
+	{
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex_);
+			auto it = index_.find(text);
+			if (it != index_.end()) {
+				count_saved(text);
+				return *it->second;
+			}
+		}
+
+		// string was not found, but it could be added by other thread before we got exclusive lock
+		std::unique_lock<std::shared_mutex> lock(mutex_);
+		auto it = index_.find(text);
+		if (it != index_.end()) {
+			count_saved(text);
+			return *it->second;
+		}
+		const std::string &stored = symbols_.emplace_back(text);
+		index_.emplace(stored, &stored);
+		return stored;
+	}
+
+	size_t symbol_table::size() const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex_);
+		return symbols_.size();
+	}
+
+	size_t symbol_table::bytes_saved() const
+	{
+		return bytes_saved_.load(std::memory_order_relaxed);
+	}
+} // namespace inicpp
@@ -0,0 +1,225 @@
+#include "tokenizer.h"
+#include "scanner.h"
+#include "string_utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace inicpp
+{
+	tokenizer::tokenizer(parse_handler &handler, bool raw_values)
+		: handler_(handler), raw_values_(raw_values), line_number_(0), next_line_offset_(0), in_section_(false),
+		  stopped_(false), name_(), value_buffers_(), values_()
+	{
+	}
+
+	void tokenizer::unescape(std::string_view str, std::string &result)
+	{
+		// values without backslash are by far the most common, copy them at once
+		if (str.find('\\') == std::string_view::npos) {
+			result.append(str);
+			return;
+		}
+
+		bool escaped = false;
+		for (char ch : str) {
+			if (escaped) {
+				// escaped character, it should remain in string
+				escaped = false;
+			} else if (ch == '\\') {
+				// next character will be escaped, so skip escaping character
+				escaped = true;
+				continue;
+			}
+			result.push_back(ch);
+		}
+	}
+
+	namespace
+	{
+		/**
+		 * Split option value into trimmed, but still escaped elements.
+		 * @param str line without comment
+		 * @param index structural characters of the line
+		 * @param begin position in line where the value starts
+		 * @param callback function called with every element
+		 */
+		template <typename Callback>
+		void split_option_list(
+			std::string_view str, const scanner::structural_index &index, size_t begin, Callback &&callback)
+		{
+			using namespace string_utils;
+			using scanner::structural;
+
+			structural delim = structural::comma;
+
+			if (index.find(structural::comma, begin) >= str.length()) {
+				// if no escaped strokes are present in given string,
+				//   try to use colon
+				delim = structural::colon;
+			}
+
+			// delimiters are taken from the index, elements are only views to the line
+			while (true) {
+				size_t pos = std::min(index.find(delim, begin), str.length());
+
+				// extract option value and process it
+				std::string_view value = left_trim(str.substr(begin, pos - begin));
+				std::string_view trimmed = right_trim(value);
+				if (index.has_backslash() && trimmed.length() < value.length() && value[trimmed.length()] == ' ') {
+					// whitespace right after the value stays if it is escaped, which means
+					//   that it is preceded by odd number of backslashes
+					size_t backslashes = 0;
+					while (backslashes < trimmed.length() && trimmed[trimmed.length() - backslashes - 1] == '\\') {
+						++backslashes;
+					}
+					if (backslashes % 2 == 1) { trimmed = value.substr(0, trimmed.length() + 1); }
+				}
+
+				callback(trimmed);
+
+				if (pos == str.length()) {
+					// no delimiter found
+					break;
+				}
+				begin = pos + 1;
+			}
+		}
+	} // namespace
+
+	void tokenizer::parse_option_list(std::string_view str, const scanner::structural_index &index, size_t begin)
+	{
+		values_.clear();
+		size_t used_buffers = 0;
+
+		// only values with escapes are copied into buffers
+		split_option_list(str, index, begin, [&](std::string_view value) {
+			if (!index.has_backslash() || value.find('\\') == std::string_view::npos) {
+				values_.push_back(value);
+			} else {
+				if (used_buffers == value_buffers_.size()) { value_buffers_.emplace_back(); }
+				std::string &buffer = value_buffers_[used_buffers++];
+				buffer.clear();
+				unescape(value, buffer);
+				values_.push_back(buffer);
+			}
+		});
+	}
+
+	void tokenizer::split_values(std::string_view raw_value, std::vector<std::string> &result)
+	{
+		scanner::structural_index index(raw_value);
+		split_option_list(raw_value, index, 0, [&](std::string_view value) { unescape(value, result.emplace_back()); });
+	}
+
+	bool tokenizer::report_error(load_error_code code, size_t position)
+	{
+		size_t offset = handler_.line_offset_ + position;
+		stopped_ = !handler_.on_load_error(load_error(code, line_number_, position + 1, offset));
+		return !stopped_;
+	}
+
+	bool tokenizer::process_line(std::string_view raw_line)
+	{
+		using namespace string_utils;
+		using scanner::structural;
+
+		++line_number_;
+		handler_.line_number_ = line_number_;
+		handler_.line_offset_ = next_line_offset_;
+		// lines are split on newline characters, which are not part of the line
+		next_line_offset_ += raw_line.length() + 1;
+
+		// all structural characters of the line are found in one pass
+		scanner::structural_index index(raw_line);
+
+		// if there was comment delete it, line is only a view so nothing is copied
+		size_t comment = index.find(structural::semicolon);
+		std::string_view content = raw_line.substr(0, comment);
+		std::string_view line = left_trim(content);
+		size_t line_begin = content.length() - line.length();
+
+		if (line.empty()) { // empty line
+		} else if (starts_with(line, "[")) { // start of section
+			line = right_trim(line);
+			if (!ends_with(line, "]")) { return report_error(load_error_code::section_not_ended, line_begin); }
+
+			// empty section name cannot be present
+			if (line.length() == 2) { return report_error(load_error_code::empty_section_name, line_begin); }
+
+			// extract name and validate it
+			name_.clear();
+			unescape(line.substr(1, line.length() - 2), name_);
+			if (!is_valid_identifier(name_)) { return report_error(load_error_code::invalid_identifier, line_begin); }
+
+			in_section_ = true;
+			if (!handler_.on_section(name_)) {
+				stopped_ = true;
+				return false;
+			}
+		} else { // option
+			size_t opt_delim = index.find(structural::equals, line_begin);
+			if (opt_delim >= content.length()) { return report_error(load_error_code::option_expected, line_begin); }
+
+			// if there is no opened section, option has no parent section
+			if (!in_section_) { return report_error(load_error_code::option_not_in_section, line_begin); }
+
+			// equals character was right at the end of line, should not be
+			if ((opt_delim + 1) == content.length()) {
+				return report_error(load_error_code::empty_option_value, opt_delim);
+			}
+
+			// retrieve option name and validate it, empty name is not valid identifier either
+			name_.clear();
+			unescape(trim(content.substr(line_begin, opt_delim - line_begin)), name_);
+			if (!is_valid_identifier(name_)) { return report_error(load_error_code::invalid_identifier, line_begin); }
+
+			if (raw_values_) {
+				values_.clear();
+				values_.push_back(content.substr(opt_delim + 1));
+			} else {
+				parse_option_list(content, index, opt_delim + 1);
+			}
+			if (!handler_.on_option(name_, values_)) {
+				stopped_ = true;
+				return false;
+			}
+		}
+
+		if (comment != std::string_view::npos && !handler_.on_comment(raw_line.substr(comment + 1))) {
+			stopped_ = true;
+			return false;
+		}
+		return true;
+	}
+
+	bool tokenizer::process_buffer(const char *data, size_t length)
+	{
+		// split buffer the same way as std::getline does, so the result is identical to the stream variant
+		const char *end = data + length;
+		while (data != end && !stopped_) {
+			auto line_end = static_cast<const char *>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+			if (line_end == nullptr) { line_end = end; }
+
+			// lines are processed in place, without copying them out of the buffer
+			process_line(std::string_view(data, static_cast<size_t>(line_end - data)));
+
+			data = (line_end == end ? end : line_end + 1);
+		}
+
+		return !stopped_;
+	}
+
+	bool tokenizer::process_stream(std::istream &str)
+	{
+		std::string line;
+		while (!stopped_ && std::getline(str, line)) { process_line(line); }
+
+		return !stopped_;
+	}
+
+	size_t tokenizer::line_number() const
+	{
+		return line_number_;
+	}
+} // namespace inicpp
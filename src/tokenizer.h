@@ -0,0 +1,113 @@
+#ifndef INICPP_TOKENIZER_H
+#define INICPP_TOKENIZER_H
+
+#include <deque>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parse_handler.h"
+
+namespace inicpp
+{
+	namespace scanner
+	{
+		/** Forward declaration of internal line scanner */
+		class structural_index;
+	} // namespace scanner
+
+	/**
+	 * Internal splitter of ini lines into elements, which are reported
+	 * to given parse_handler. Buffers for unescaped names and values are reused
+	 * between lines, so memory usage does not depend on the size of the input.
+	 */
+	class tokenizer
+	{
+	private:
+		/** Receiver of parsed elements */
+		parse_handler &handler_;
+		/** True if option values are reported unsplit and escaped */
+		bool raw_values_;
+		/** Number of processed lines */
+		size_t line_number_;
+		/** Offset of the beginning of the next line in bytes */
+		size_t next_line_offset_;
+		/** True if some section header was already seen */
+		bool in_section_;
+		/** True if handler requested stop of parsing */
+		bool stopped_;
+		/** Buffer for unescaped name of element */
+		std::string name_;
+		/** Buffers for unescaped values, deque keeps them on stable addresses */
+		std::deque<std::string> value_buffers_;
+		/** Values of currently processed option */
+		std::vector<std::string_view> values_;
+
+		/**
+		 * Split option value into list of unescaped values stored in values_.
+		 * @param str line without comment
+		 * @param index structural characters of the line
+		 * @param begin position in line where the value starts
+		 */
+		void parse_option_list(std::string_view str, const scanner::structural_index &index, size_t begin);
+		/**
+		 * Report error on current line to the handler.
+		 * @param code reason of the error
+		 * @param position position of the error in current line, starting from 0
+		 * @return true if parsing should continue
+		 */
+		bool report_error(load_error_code code, size_t position);
+
+	public:
+		/**
+		 * Construct tokenizer reporting to given handler.
+		 * @param handler receiver of parsed elements, has to outlive tokenizer
+		 * @param raw_values if true, every option is reported with one value containing
+		 *   raw text after the equals sign, which can be split later by split_values()
+		 */
+		explicit tokenizer(parse_handler &handler, bool raw_values = false);
+
+		tokenizer(const tokenizer &) = delete;
+		tokenizer &operator=(const tokenizer &) = delete;
+
+		/**
+		 * Process one line of ini configuration.
+		 * @param line content of the line without terminating newline
+		 * @return true if parsing should continue
+		 */
+		bool process_line(std::string_view line);
+		/**
+		 * Process all lines of given buffer, which is split the same way as std::getline() does.
+		 * @param data buffer with ini configuration
+		 * @param length size of the buffer
+		 * @return true if whole buffer was processed
+		 */
+		bool process_buffer(const char *data, size_t length);
+		/**
+		 * Process all lines of given stream.
+		 * @param str stream with ini configuration
+		 * @return true if whole stream was processed
+		 */
+		bool process_stream(std::istream &str);
+		/**
+		 * Number of already processed lines.
+		 */
+		size_t line_number() const;
+
+		/**
+		 * Removes escaping characters from given string and appends the result
+		 * to the @a result string. Runs in linear time.
+		 */
+		static void unescape(std::string_view str, std::string &result);
+		/**
+		 * Split raw option value into list of unescaped values, the same way
+		 * as option values are split when the whole line is processed.
+		 * @param raw_value text of the line after the equals sign, without comment
+		 * @param result list to which values are appended
+		 */
+		static void split_values(std::string_view raw_value, std::vector<std::string> &result);
+	};
+} // namespace inicpp
+
+#endif // INICPP_TOKENIZER_H
@@ -0,0 +1,160 @@
+#include "value_list.h"
+#include "exception.h"
+#include "symbol_table.h"
+
+namespace inicpp
+{
+	value_list::value_list(const value_list &source) : value_list()
+	{
+		copy_from(source);
+	}
+
+	value_list &value_list::operator=(const value_list &source)
+	{
+		if (this != &source) {
+			release();
+			copy_from(source);
+		}
+		return *this;
+	}
+
+	value_list::value_list(value_list &&source) noexcept : value_list()
+	{
+		move_from(source);
+	}
+
+	value_list &value_list::operator=(value_list &&source) noexcept
+	{
+		if (this != &source) {
+			release();
+			move_from(source);
+		}
+		return *this;
+	}
+
+	value_list::~value_list()
+	{
+		release();
+	}
+
+	void value_list::release()
+	{
+		if (layout_ == layout::heap) { delete heap(); }
+		layout_ = layout::empty;
+	}
+
+	void value_list::copy_from(const value_list &source)
+	{
+		// inline values are trivially copyable, only heap array has to be duplicated
+		if (source.layout_ == layout::heap) {
+			set_heap(new arrays(*source.heap()));
+		} else {
+			std::memcpy(storage_, source.storage_, small_capacity);
+			layout_ = source.layout_;
+		}
+		length_ = source.length_;
+		type_ = source.type_;
+	}
+
+	void value_list::move_from(value_list &source) noexcept
+	{
+		// pointer to heap array is moved as a plain bytes of inline storage
+		std::memcpy(storage_, source.storage_, small_capacity);
+		length_ = source.length_;
+		layout_ = source.layout_;
+		type_ = source.type_;
+		source.layout_ = layout::empty;
+	}
+
+	size_t value_list::size() const
+	{
+		switch (layout_) {
+		case layout::empty: return 0;
+		case layout::heap: return std::visit([](const auto &values) { return values.size(); }, *heap());
+		default: return 1;
+		}
+	}
+
+	std::string_view value_list::string_at(size_t index) const
+	{
+		if (layout_ == layout::empty) { throw not_found_exception(index); }
+		if (layout_ == layout::small) { return std::string_view(storage_, length_); }
+		if (layout_ == layout::shared) { return symbol(); }
+		return std::get<std::vector<string_ini_t>>(*heap())[index];
+	}
+
+	option_value value_list::operator[](size_t index) const
+	{
+		switch (layout_) {
+		case layout::scalar:
+			switch (type_) {
+			case type_id<boolean_ini_t>(): return *inline_value<boolean_ini_t>();
+			case type_id<signed_ini_t>(): return *inline_value<signed_ini_t>();
+			case type_id<unsigned_ini_t>(): return *inline_value<unsigned_ini_t>();
+			default: return *inline_value<float_ini_t>();
+			}
+		case layout::small:
+		case layout::shared:
+			if (type_ == type_id<enum_ini_t>()) { return get<enum_ini_t>(index); }
+			return get<string_ini_t>(index);
+		default: return std::visit([index](const auto &values) { return option_value(values[index]); }, *heap());
+		}
+	}
+
+	void value_list::erase(size_t index)
+	{
+		if (layout_ == layout::heap) {
+			std::visit(
+				[index](auto &values) { values.erase(std::next(values.begin(), static_cast<std::ptrdiff_t>(index))); },
+				*heap());
+		} else {
+			release();
+		}
+	}
+
+	void value_list::clear()
+	{
+		release();
+	}
+
+	void value_list::intern(symbol_table &symbols)
+	{
+		if (layout_ != layout::heap || size() != 1) { return; }
+
+		const std::string *interned = nullptr;
+		if (auto strings = array<string_ini_t>()) {
+			interned = &symbols.intern(strings->front());
+		} else if (auto enums = array<enum_ini_t>()) {
+			interned = &symbols.intern(static_cast<std::string>(enums->front()));
+		}
+		if (interned != nullptr) {
+			uint8_t type = type_;
+			release();
+			new (storage_) const std::string *(interned);
+			layout_ = layout::shared;
+			type_ = type;
+		}
+	}
+
+	bool value_list::operator==(const value_list &other) const
+	{
+		size_t count = size();
+		if (count != other.size()) { return false; }
+		if (count == 0) { return true; }
+		if (type_ != other.type_) { return false; }
+		if (layout_ == layout::heap && other.layout_ == layout::heap) { return *heap() == *other.heap(); }
+		if (layout_ == layout::shared && other.layout_ == layout::shared && &symbol() == &other.symbol()) {
+			return true;
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			if ((*this)[i] != other[i]) { return false; }
+		}
+		return true;
+	}
+
+	bool value_list::operator!=(const value_list &other) const
+	{
+		return !(*this == other);
+	}
+} // namespace inicpp
@@ -0,0 +1,68 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "bound_option.h"
+#include "parser.h"
+
+using namespace inicpp;
+
+
+TEST(bound_option, reading_and_refreshing)
+{
+	config conf = parser::load("[sect]\nnumber = 5\nlist = 1, 2, 3\ntext = abc\n");
+	bound_option<signed_ini_t> number(conf, "sect", "number");
+	EXPECT_EQ(number.section_name(), "sect");
+	EXPECT_EQ(number.option_name(), "number");
+	EXPECT_EQ(number.get(), 5);
+	EXPECT_EQ(&number.get(), &*number);
+	bound_option<unsigned_ini_t> list(conf, "sect", "list");
+	EXPECT_EQ(list.get(), 1u);
+
+	// modification of the option through any path is noticed
+	conf["sect"]["number"] = signed_ini_t(6);
+	EXPECT_EQ(number.get(), 6);
+	conf["sect"]["number"].set_list<signed_ini_t>({7, 8});
+	EXPECT_EQ(number.get(), 7);
+	conf["sect"]["number"].remove_from_list_pos(0);
+	EXPECT_EQ(number.get(), 8);
+	conf["sect"]["number"] = option("number", "9");
+	EXPECT_EQ(number.get(), 9);
+
+	// so is removal of the option or replacement of whole config
+	conf.remove_option("sect", "number");
+	EXPECT_THROW(number.get(), not_found_exception);
+	conf.add_option("sect", "number", signed_ini_t(10));
+	EXPECT_EQ(number.get(), 10);
+	conf = parser::load("[sect]\nnumber = 11\n");
+	EXPECT_EQ(number.get(), 11);
+	conf["sect"] = section("sect");
+	EXPECT_THROW(number.get(), not_found_exception);
+	conf.remove_section("sect");
+	EXPECT_THROW(number.get(), not_found_exception);
+	conf.add_section("sect");
+	conf.add_option("sect", "number", signed_ini_t(12));
+	EXPECT_EQ(number.get(), 12);
+}
+
+TEST(bound_option, conversion_errors_and_defaults)
+{
+	config conf = parser::load("[sect]\ntext = abc\nnumber = 5\n");
+	bound_option<signed_ini_t> text(conf, "sect", "text");
+	EXPECT_THROW(text.get(), bad_cast_exception);
+	// failed conversion is not cached
+	EXPECT_THROW(text.get(), bad_cast_exception);
+	conf["sect"]["text"] = signed_ini_t(1);
+	EXPECT_EQ(text.get(), 1);
+
+	bound_option<signed_ini_t> with_default(conf, "sect", "missing", 42);
+	EXPECT_EQ(with_default.get(), 42);
+	conf.add_option("sect", "missing", string_ini_t("abc"));
+	EXPECT_EQ(with_default.get(), 42);
+	conf["sect"]["missing"] = signed_ini_t(3);
+	EXPECT_EQ(with_default.get(), 3);
+
+	bound_option<string_ini_t> missing_section(conf, "missing", "number", "default");
+	EXPECT_EQ(missing_section.get(), "default");
+	bound_option<string_ini_t> number(conf, "sect", "number", "default");
+	EXPECT_EQ(number.get(), "5");
+}
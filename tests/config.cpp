@@ -5,8 +5,35 @@
 #include "option.h"
 #include "section.h"
 
+#include <memory_resource>
+
 using namespace inicpp;
 
+namespace
+{
+	/** Memory resource which counts allocated blocks */
+	class counting_resource : public std::pmr::memory_resource
+	{
+	public:
+		size_t allocations = 0;
+
+	private:
+		void *do_allocate(size_t bytes, size_t alignment) override
+		{
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+} // namespace
+
 
 TEST(config, creation_and_assignments)
 {
@@ -42,6 +69,61 @@ TEST(config, adding_and_removing_sections)
 	EXPECT_EQ(conf[0].get_name(), "sect2");
 }
 
+TEST(config, many_sections_lookup)
+{
+	config conf;
+	for (size_t i = 0; i < 1000; ++i) { conf.add_section("sect" + std::to_string(i)); }
+	EXPECT_THROW(conf.add_section("sect500"), ambiguity_exception);
+
+	// removal shifts positions of following sections
+	for (size_t i = 0; i < 1000; i += 3) { conf.remove_section("sect" + std::to_string(i)); }
+	EXPECT_THROW(conf.remove_section("sect0"), not_found_exception);
+	EXPECT_EQ(conf.size(), 666u);
+
+	config copy(conf);
+	for (size_t i = 0; i < 1000; ++i) {
+		std::string name = "sect" + std::to_string(i);
+		EXPECT_EQ(conf.contains(name), i % 3 != 0);
+		EXPECT_EQ(copy.contains(name), i % 3 != 0);
+		if (i % 3 != 0) {
+			EXPECT_EQ(conf[name].get_name(), name);
+			EXPECT_EQ(copy[name].get_name(), name);
+		} else {
+			EXPECT_THROW(conf[name], not_found_exception);
+		}
+	}
+	EXPECT_EQ(conf[0].get_name(), "sect1");
+	EXPECT_EQ(conf[665].get_name(), "sect998");
+
+	conf.add_section("sect0");
+	EXPECT_EQ(conf[666].get_name(), "sect0");
+	EXPECT_FALSE(copy.contains("sect0"));
+}
+
+TEST(config, string_view_lookup)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option("sect", "opt", signed_ini_t(5));
+
+	// views into a larger buffer, which are not null terminated
+	std::string buffer = "sect#opt";
+	std::string_view sect_name = std::string_view(buffer).substr(0, 4);
+	std::string_view opt_name = std::string_view(buffer).substr(5);
+	EXPECT_TRUE(conf.contains(sect_name));
+	EXPECT_EQ(conf[sect_name][opt_name].get<signed_ini_t>(), 5);
+	EXPECT_FALSE(conf.contains(std::string_view(buffer).substr(0, 3)));
+	EXPECT_THROW(conf[std::string_view(buffer).substr(1, 3)], not_found_exception);
+
+	const config &const_conf = conf;
+	EXPECT_EQ(const_conf["sect"]["opt"].get<signed_ini_t>(), 5);
+
+	conf.remove_option(sect_name, opt_name);
+	EXPECT_FALSE(conf[sect_name].contains(opt_name));
+	conf.remove_section(sect_name);
+	EXPECT_EQ(conf.size(), 0u);
+}
+
 TEST(config, adding_and_removing_options)
 {
 	config conf;
@@ -87,3 +169,186 @@ TEST(config, stream_output)
 	str << conf;
 	EXPECT_EQ(str.str(), "[sect_name]\n[name2]\n");
 }
+
+TEST(config, find_try_get_and_get_or)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option("sect", "opt", string_ini_t("1.5"));
+	conf.add_option("sect", "text", string_ini_t("abc"));
+
+	ASSERT_NE(conf.find("sect"), nullptr);
+	EXPECT_EQ(conf.find("sect")->get_name(), "sect");
+	EXPECT_EQ(conf.find("missing"), nullptr);
+	const config &const_conf = conf;
+	EXPECT_EQ(const_conf.find("sect"), &conf["sect"]);
+
+	EXPECT_EQ(conf.try_get<float_ini_t>("sect", "opt"), std::optional<float_ini_t>(1.5));
+	EXPECT_EQ(conf.try_get<float_ini_t>("sect", "missing"), std::nullopt);
+	EXPECT_EQ(conf.try_get<float_ini_t>("missing", "opt"), std::nullopt);
+	EXPECT_EQ(conf.try_get<signed_ini_t>("sect", "text"), std::nullopt);
+	EXPECT_EQ(conf.get_or<float_ini_t>("sect", "opt", 0.0), 1.5);
+	EXPECT_EQ(conf.get_or<string_ini_t>("missing", "opt", "default"), "default");
+	EXPECT_EQ(conf.get_or<signed_ini_t>("sect", "text", 3), 3);
+}
+
+TEST(config, key_handle)
+{
+	config conf;
+	conf.add_section("sect");
+	conf.add_option("sect", "opt", signed_ini_t(5));
+	conf.add_option("sect", "other", signed_ini_t(6));
+
+	config::key_handle handle = conf.handle("sect", "opt");
+	EXPECT_EQ(handle.section_name(), "sect");
+	EXPECT_EQ(handle.option_name(), "opt");
+	EXPECT_TRUE(conf.is_current(handle));
+	EXPECT_EQ(&conf[handle], &conf["sect"]["opt"]);
+	EXPECT_EQ(conf[handle].get<signed_ini_t>(), 5);
+	conf[handle].set<signed_ini_t>(7);
+	EXPECT_EQ(conf["sect"]["opt"].get<signed_ini_t>(), 7);
+
+	// appending elements keeps the handle current
+	for (int i = 0; i < 20; ++i) {
+		conf.add_section("added" + std::to_string(i));
+		conf.add_option("sect", "added" + std::to_string(i), signed_ini_t(i));
+	}
+	EXPECT_TRUE(conf.is_current(handle));
+
+	// removal of options makes the handle stale, it is resolved again on access
+	conf.remove_option("sect", "other");
+	EXPECT_FALSE(conf.is_current(handle));
+	EXPECT_EQ(&conf[handle], &conf["sect"]["opt"]);
+	EXPECT_TRUE(conf.is_current(handle));
+	conf.remove_option("sect", "opt");
+	EXPECT_EQ(conf.find(handle), nullptr);
+	EXPECT_FALSE(conf.is_current(handle));
+	EXPECT_THROW(conf[handle], not_found_exception);
+	conf.add_option("sect", "opt", signed_ini_t(8));
+	EXPECT_EQ(conf[handle].get<signed_ini_t>(), 8);
+
+	// so does replacement or removal of sections
+	conf["sect"] = section("sect");
+	EXPECT_FALSE(conf.is_current(handle));
+	EXPECT_EQ(conf.find(handle), nullptr);
+	conf.remove_section("sect");
+	EXPECT_EQ(conf.find(handle), nullptr);
+	EXPECT_THROW(conf[handle], not_found_exception);
+	conf.add_section("sect");
+	conf.add_option("sect", "opt", signed_ini_t(9));
+	EXPECT_EQ(conf[handle].get<signed_ini_t>(), 9);
+
+	// handle is resolved against other config on its first use
+	config copy(conf);
+	EXPECT_FALSE(copy.is_current(handle));
+	EXPECT_EQ(&copy[handle], &copy["sect"]["opt"]);
+	EXPECT_FALSE(conf.is_current(handle));
+	const config &const_conf = conf;
+	EXPECT_EQ(&const_conf[handle], &conf["sect"]["opt"]);
+
+	// moved config keeps its elements, so handles stay current
+	config moved(std::move(conf));
+	EXPECT_TRUE(moved.is_current(handle));
+	EXPECT_EQ(moved[handle].get<signed_ini_t>(), 9);
+
+	config::key_handle unresolved("missing", "opt");
+	EXPECT_FALSE(moved.is_current(unresolved));
+	EXPECT_EQ(moved.find(unresolved), nullptr);
+	EXPECT_THROW(moved[unresolved], not_found_exception);
+}
+
+TEST(config, emplace_and_move_sections)
+{
+	config conf;
+	section &emplaced = conf.emplace_section("first");
+	EXPECT_EQ(&emplaced, &conf["first"]);
+	EXPECT_THROW(conf.emplace_section("first"), ambiguity_exception);
+
+	section sect("second");
+	sect.add_option("opt", "value");
+	conf.add_section(std::move(sect));
+	EXPECT_EQ(conf.size(), 2u);
+	EXPECT_EQ(conf["second"]["opt"].get<string_ini_t>(), "value");
+	EXPECT_THROW(conf.add_section(section("second")), ambiguity_exception);
+	EXPECT_EQ(conf["second"].size(), 1u);
+
+	option &opt = conf.emplace_option("first", "list", std::vector<std::string>{"1", "2"});
+	EXPECT_EQ(&opt, &conf["first"]["list"]);
+	EXPECT_EQ(opt.get_list<signed_ini_t>(), (std::vector<signed_ini_t>{1, 2}));
+	EXPECT_THROW(conf.emplace_option("missing", "list"), not_found_exception);
+	conf.add_option("first", option("moved", "value"));
+	EXPECT_EQ(conf["first"]["moved"].get<string_ini_t>(), "value");
+	EXPECT_THROW(conf.add_option("missing", option("moved", "value")), not_found_exception);
+}
+
+TEST(config, assignment_keeps_stored_names)
+{
+	config conf;
+	conf.add_section("a");
+	conf.add_option("a", "x", "1");
+
+	// stored elements keep the name they are found by
+	section other("b");
+	other.add_option("y", "2");
+	conf["a"] = other;
+	EXPECT_EQ(conf["a"].get_name(), "a");
+	EXPECT_FALSE(conf.contains("b"));
+	EXPECT_EQ(conf["a"]["y"].get<signed_ini_t>(), 2);
+	conf["a"]["y"] = option("z", "3");
+	EXPECT_EQ(conf["a"]["y"].get_name(), "y");
+	EXPECT_EQ(conf["a"]["y"].get<signed_ini_t>(), 3);
+	conf["a"] = section("c");
+	EXPECT_EQ(conf["a"].get_name(), "a");
+	EXPECT_EQ(conf["a"].size(), 0u);
+
+	// copies of the config store their own elements
+	conf.add_option("a", "x", "4");
+	config copy(conf);
+	copy["a"]["x"] = option("w", "5");
+	EXPECT_EQ(copy["a"]["x"].get<signed_ini_t>(), 5);
+	EXPECT_EQ(conf["a"]["x"].get<signed_ini_t>(), 4);
+
+	// elements which are not stored take name of the assigned one
+	section standalone = conf["a"];
+	standalone = other;
+	EXPECT_EQ(standalone.get_name(), "b");
+}
+
+TEST(config, memory_resource)
+{
+	counting_resource arena;
+	config conf(&arena);
+	EXPECT_EQ(conf.get_memory_resource(), &arena);
+	conf.add_section("first");
+	conf.add_option("first", "number", static_cast<signed_ini_t>(5));
+	conf.add_section(section("second"));
+	conf.emplace_option("second", "text", "value");
+	EXPECT_GE(arena.allocations, 4u);
+	EXPECT_EQ(conf["first"].get_memory_resource(), &arena);
+	EXPECT_EQ(conf["second"].get_memory_resource(), &arena);
+
+	// copy uses default resource, or given one
+	config copy(conf);
+	EXPECT_EQ(copy.get_memory_resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(copy["second"].get_memory_resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(copy, conf);
+	size_t before_copy = arena.allocations;
+	config arena_copy(copy, &arena);
+	EXPECT_GT(arena.allocations, before_copy);
+	EXPECT_EQ(arena_copy, conf);
+
+	// move keeps resource of the source, move assignment keeps resource of the target
+	config moved(std::move(arena_copy));
+	EXPECT_EQ(moved.get_memory_resource(), &arena);
+	EXPECT_EQ(moved, conf);
+	config::key_handle handle = copy.handle("second", "text");
+	EXPECT_EQ(copy[handle].get<string_ini_t>(), "value");
+	moved = std::move(copy);
+	EXPECT_EQ(moved.get_memory_resource(), &arena);
+	EXPECT_EQ(moved["second"].get_memory_resource(), &arena);
+	EXPECT_EQ(moved, conf);
+	EXPECT_EQ(moved[handle].get<string_ini_t>(), "value");
+	copy = moved;
+	EXPECT_EQ(copy.get_memory_resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(copy, conf);
+}
@@ -0,0 +1,142 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "config.h"
+#include "frozen_config.h"
+#include "parser.h"
+
+#include <string>
+
+using namespace inicpp;
+
+
+TEST(frozen_config, typed_values)
+{
+	config conf;
+	conf.add_section("values");
+	conf.add_option<boolean_ini_t>("values", "flag", true);
+	conf.add_option<signed_ini_t>("values", "signed", -5);
+	conf.add_option<unsigned_ini_t>("values", "unsigned", 7u);
+	conf.add_option<float_ini_t>("values", "float", 2.5);
+	conf.add_option<enum_ini_t>("values", "enum", enum_ini_t("first"));
+	conf.add_option<string_ini_t>("values", "string", "text");
+
+	frozen_config frozen = conf.freeze();
+	frozen_section sect = frozen["values"];
+	EXPECT_EQ(sect.get_name(), "values");
+	EXPECT_EQ(sect.size(), 6u);
+	EXPECT_TRUE(sect["flag"].get<boolean_ini_t>());
+	EXPECT_EQ(sect["signed"].get<signed_ini_t>(), -5);
+	EXPECT_EQ(sect["unsigned"].get<unsigned_ini_t>(), 7u);
+	EXPECT_DOUBLE_EQ(sect["float"].get<float_ini_t>(), 2.5);
+	EXPECT_EQ(static_cast<std::string>(sect["enum"].get<enum_ini_t>()), "first");
+	EXPECT_EQ(sect["string"].get<string_ini_t>(), "text");
+
+	EXPECT_TRUE(sect["signed"].holds_type<signed_ini_t>());
+	EXPECT_FALSE(sect["signed"].holds_type<string_ini_t>());
+	EXPECT_EQ(sect["signed"].get<string_ini_t>(), "-5");
+	EXPECT_THROW(sect["flag"].get<signed_ini_t>(), bad_cast_exception);
+}
+
+TEST(frozen_config, parsed_values_and_lists)
+{
+	config conf = parser::load("[first]\nnumber = 42\nlist = 1,2,3\nname = inicpp\n[second]\nnumber = 1.5\n");
+	frozen_config frozen(conf);
+
+	EXPECT_EQ(frozen.size(), 2u);
+	EXPECT_EQ(frozen["first"]["number"].get<signed_ini_t>(), 42);
+	EXPECT_EQ(frozen["second"]["number"].get<float_ini_t>(), 1.5);
+	EXPECT_THROW(frozen["first"]["name"].get<signed_ini_t>(), bad_cast_exception);
+
+	frozen_option list = frozen["first"]["list"];
+	EXPECT_TRUE(list.is_list());
+	EXPECT_EQ(list.size(), 3u);
+	EXPECT_EQ(list.get_list<unsigned_ini_t>(), (std::vector<unsigned_ini_t>{1, 2, 3}));
+	EXPECT_EQ(list.at<signed_ini_t>(2), 3);
+	EXPECT_EQ(list.get<signed_ini_t>(), 1);
+	EXPECT_THROW(list.at<signed_ini_t>(3), not_found_exception);
+	EXPECT_FALSE(frozen["first"]["name"].is_list());
+}
+
+TEST(frozen_config, lookups)
+{
+	config conf = parser::load("[first]\na = 1\n[second]\nb = 2\n");
+	frozen_config frozen = conf.freeze();
+
+	EXPECT_TRUE(frozen.contains("first"));
+	EXPECT_FALSE(frozen.contains("third"));
+	EXPECT_THROW(frozen["third"], not_found_exception);
+	EXPECT_THROW(frozen[2], not_found_exception);
+	EXPECT_FALSE(frozen.find("third"));
+	EXPECT_EQ(frozen.find("second")->get_name(), "second");
+
+	// options are looked up only in their own section
+	EXPECT_TRUE(frozen["first"].contains("a"));
+	EXPECT_FALSE(frozen["first"].contains("b"));
+	EXPECT_THROW(frozen["first"]["b"], not_found_exception);
+	EXPECT_THROW(frozen["first"][1], not_found_exception);
+	EXPECT_FALSE(frozen["second"].find("a"));
+
+	EXPECT_EQ(frozen.try_get<signed_ini_t>("second", "b"), 2);
+	EXPECT_FALSE(frozen.try_get<signed_ini_t>("second", "a"));
+	EXPECT_FALSE(frozen.try_get<signed_ini_t>("third", "a"));
+	EXPECT_EQ(frozen.get_or<signed_ini_t>("first", "a", 5), 1);
+	EXPECT_EQ(frozen.get_or<signed_ini_t>("first", "b", 5), 5);
+	EXPECT_EQ(frozen["first"].try_get<string_ini_t>("a"), "1");
+	EXPECT_EQ(frozen["first"].get_or<boolean_ini_t>("a", true), true);
+}
+
+TEST(frozen_config, iteration_and_copies)
+{
+	config conf = parser::load("[first]\na = 1\nb = 2\n[second]\nc = 3\n");
+	frozen_config frozen = conf.freeze();
+
+	std::vector<std::string> names;
+	for (const frozen_section &sect : frozen) {
+		names.emplace_back(sect.get_name());
+		for (const frozen_option &opt : sect) { names.emplace_back(opt.get_name()); }
+	}
+	EXPECT_EQ(names, (std::vector<std::string>{"first", "a", "b", "second", "c"}));
+
+	frozen_config copy_constructed(frozen);
+	EXPECT_EQ(copy_constructed["second"]["c"].get<signed_ini_t>(), 3);
+	EXPECT_EQ(copy_constructed.memory_usage(), frozen.memory_usage());
+	frozen_config move_constructed(std::move(copy_constructed));
+	EXPECT_EQ(move_constructed["first"]["b"].get<signed_ini_t>(), 2);
+	frozen_config assigned;
+	assigned = move_constructed;
+	EXPECT_EQ(assigned["first"]["a"].get<signed_ini_t>(), 1);
+
+	frozen_config empty;
+	EXPECT_EQ(empty.size(), 0u);
+	EXPECT_FALSE(empty.contains("first"));
+	EXPECT_TRUE(empty.begin() == empty.end());
+	frozen_config frozen_empty = config().freeze();
+	EXPECT_EQ(frozen_empty.size(), 0u);
+	EXPECT_TRUE(frozen_empty.begin() == frozen_empty.end());
+}
+
+TEST(frozen_config, many_names)
+{
+	config conf;
+	for (size_t i = 0; i < 100; ++i) {
+		std::string section_name = "section" + std::to_string(i);
+		conf.add_section(section_name);
+		for (size_t j = 0; j < 20; ++j) {
+			conf.add_option<unsigned_ini_t>(section_name, "option" + std::to_string(j), i * 100 + j);
+		}
+	}
+
+	frozen_config frozen = conf.freeze();
+	EXPECT_EQ(frozen.size(), 100u);
+	EXPECT_GT(frozen.memory_usage(), 100u * 20u * sizeof(uint64_t));
+	for (size_t i = 0; i < 100; ++i) {
+		frozen_section sect = frozen["section" + std::to_string(i)];
+		EXPECT_EQ(sect.size(), 20u);
+		for (size_t j = 0; j < 20; ++j) {
+			EXPECT_EQ(sect["option" + std::to_string(j)].get<unsigned_ini_t>(), i * 100 + j);
+		}
+		EXPECT_FALSE(sect.contains("option20"));
+	}
+	EXPECT_FALSE(frozen.contains("section100"));
+}
@@ -3,6 +3,7 @@
 
 #include "option.h"
 #include "types.h"
+#include <thread>
 #include <vector>
 
 using namespace std::literals;
@@ -126,6 +127,15 @@ TEST(option, copying)
 	moved_assignment = std::move(copied_assingment);
 	EXPECT_EQ(moved_assignment.get_name(), my_option.get_name());
 	EXPECT_EQ(moved_assignment.get<string_ini_t>(), my_option.get<string_ini_t>());
+
+	// list and enum values are moved into the option
+	std::vector<std::string> values = {"first", "second"};
+	option moved_list("list", std::move(values));
+	EXPECT_EQ(moved_list.get_list<string_ini_t>(), (std::vector<string_ini_t>{"first", "second"}));
+	enum_ini_t enum_value("value");
+	option enum_option("enum");
+	enum_option.set<enum_ini_t>(std::move(enum_value));
+	EXPECT_EQ(static_cast<std::string>(enum_option.get<enum_ini_t>()), "value");
 }
 
 /**
@@ -177,3 +187,235 @@ TEST(option, writing_to_stream)
 	str << my_option;
 	EXPECT_EQ(str.str(), "name = option 1,option 2\n");
 }
+
+/**
+ * Test that remembered conversions of string values follow modifications.
+ */
+TEST(option, conversion_cache)
+{
+	option my_option("name", std::vector<std::string>{"42", "0x10", "-1"});
+
+	// conversion is remembered but string form stays
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 42);
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 42);
+	EXPECT_EQ(my_option.get_list<signed_ini_t>(), (std::vector<signed_ini_t>{42, 16, -1}));
+	EXPECT_TRUE(my_option.holds_type<string_ini_t>());
+	EXPECT_EQ(my_option.get<string_ini_t>(), "42");
+	EXPECT_EQ(my_option.get<float_ini_t>(), 42.0);
+	EXPECT_EQ(my_option.get_list<float_ini_t>(), (std::vector<float_ini_t>{42.0, 16.0, -1.0}));
+
+	// every modification drops remembered values
+	my_option.remove_from_list_pos(0);
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 16);
+	my_option.add_to_list<string_ini_t>("7", 0);
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 7);
+	my_option.remove_from_list<string_ini_t>("7");
+	EXPECT_EQ(my_option.get_list<signed_ini_t>(), (std::vector<signed_ini_t>{16, -1}));
+	my_option.add_to_list<string_ini_t>("5");
+	EXPECT_EQ(my_option.get_list<signed_ini_t>(), (std::vector<signed_ini_t>{16, -1, 5}));
+	my_option = "8";
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 8);
+	my_option.set_list<string_ini_t>({"9", "x"});
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 9);
+	EXPECT_THROW(my_option.get_list<signed_ini_t>(), bad_cast_exception);
+	// failed conversion of the list does not affect reading of single values
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 9);
+	EXPECT_EQ(my_option.get<unsigned_ini_t>(), 9u);
+	EXPECT_THROW(my_option.at<signed_ini_t>(1), bad_cast_exception);
+	EXPECT_THROW(my_option.values<signed_ini_t>(), bad_cast_exception);
+
+	// copies do not share remembered values
+	option copied(my_option);
+	my_option = "10";
+	EXPECT_EQ(my_option.get<signed_ini_t>(), 10);
+	EXPECT_EQ(copied.get<signed_ini_t>(), 9);
+	option moved(std::move(copied));
+	EXPECT_EQ(moved.get<signed_ini_t>(), 9);
+	moved = option("other", "11");
+	EXPECT_EQ(moved.get<signed_ini_t>(), 11);
+
+	// concurrent readers of the same option
+	const option shared("shared", std::vector<std::string>{"1", "2", "3"});
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < 4; ++i) {
+		threads.emplace_back([&shared]() {
+			for (size_t j = 0; j < 1000; ++j) {
+				EXPECT_EQ(shared.get<unsigned_ini_t>(), 1u);
+				EXPECT_EQ(shared.get_list<unsigned_ini_t>(), (std::vector<unsigned_ini_t>{1, 2, 3}));
+			}
+		});
+	}
+	for (auto &thread : threads) { thread.join(); }
+}
+
+TEST(option, try_get_and_get_or)
+{
+	option str_option("name", std::vector<std::string>{"42", "x"});
+	EXPECT_EQ(str_option.try_get<signed_ini_t>(), std::optional<signed_ini_t>(42));
+	EXPECT_EQ(str_option.try_get<string_ini_t>(), std::optional<string_ini_t>("42"));
+	EXPECT_EQ(str_option.try_get<boolean_ini_t>(), std::nullopt);
+	EXPECT_EQ(str_option.get_or<boolean_ini_t>(true), true);
+	EXPECT_EQ(str_option.get_or<float_ini_t>(1.5), 42.0);
+	// remembered conversion is used too
+	EXPECT_EQ(str_option.get<unsigned_ini_t>(), 42u);
+	EXPECT_EQ(str_option.try_get<unsigned_ini_t>(), std::optional<unsigned_ini_t>(42));
+
+	option bad_option("name", "not a number");
+	EXPECT_EQ(bad_option.try_get<signed_ini_t>(), std::nullopt);
+	EXPECT_EQ(bad_option.try_get<float_ini_t>(), std::nullopt);
+	EXPECT_EQ(bad_option.get_or<signed_ini_t>(-1), -1);
+	EXPECT_EQ(bad_option.get_or<string_ini_t>("default"), "not a number");
+
+	// typed values are not converted between each other
+	option typed_option("name");
+	typed_option = signed_ini_t(-5);
+	EXPECT_EQ(typed_option.try_get<signed_ini_t>(), std::optional<signed_ini_t>(-5));
+	EXPECT_EQ(typed_option.try_get<unsigned_ini_t>(), std::nullopt);
+	EXPECT_EQ(typed_option.try_get<string_ini_t>(), std::optional<string_ini_t>("-5"));
+	EXPECT_EQ(typed_option.get_or<float_ini_t>(2.5), 2.5);
+
+	option empty_option("name");
+	empty_option.remove_from_list_pos(0);
+	EXPECT_EQ(empty_option.try_get<string_ini_t>(), std::nullopt);
+	EXPECT_EQ(empty_option.get_or<string_ini_t>("default"), "default");
+}
+
+TEST(option, values_view_size_and_at)
+{
+	option numbers("numbers");
+	numbers.set_list<signed_ini_t>({1, 2, 3});
+	EXPECT_EQ(numbers.size(), 3u);
+	value_view<signed_ini_t> view = numbers.values<signed_ini_t>();
+	EXPECT_EQ(view.size(), 3u);
+	EXPECT_FALSE(view.empty());
+	EXPECT_EQ(std::vector<signed_ini_t>(view.begin(), view.end()), (std::vector<signed_ini_t>{1, 2, 3}));
+	EXPECT_EQ(view[1], 2);
+	EXPECT_EQ(view.at(2), 3);
+	EXPECT_THROW(view.at(3), not_found_exception);
+	EXPECT_EQ(view.end() - view.begin(), 3);
+	// stored values are viewed in place
+	EXPECT_EQ(&view[0], &numbers.values<signed_ini_t>()[0]);
+	EXPECT_THROW(numbers.values<float_ini_t>(), bad_cast_exception);
+	EXPECT_EQ(numbers.at<signed_ini_t>(1), 2);
+	EXPECT_EQ(numbers.at<string_ini_t>(2), "3");
+	EXPECT_THROW(numbers.at<signed_ini_t>(3), not_found_exception);
+	EXPECT_EQ(numbers.values<string_ini_t>().at(0), "1");
+
+	// strings are converted once, the conversion is viewed until modification
+	option strings("strings", std::vector<std::string>{"4", "5", "6"});
+	value_view<unsigned_ini_t> converted = strings.values<unsigned_ini_t>();
+	EXPECT_EQ(std::vector<unsigned_ini_t>(converted.begin(), converted.end()), (std::vector<unsigned_ini_t>{4, 5, 6}));
+	EXPECT_EQ(&converted[0], &strings.values<unsigned_ini_t>()[0]);
+	EXPECT_EQ(strings.at<unsigned_ini_t>(2), 6u);
+	EXPECT_EQ(strings.values<string_ini_t>()[1], "5");
+	// other conversion than the remembered one still works
+	value_view<float_ini_t> floats = strings.values<float_ini_t>();
+	EXPECT_EQ(floats.size(), 3u);
+	EXPECT_EQ(floats[2], 6.0);
+	strings.add_to_list<string_ini_t>("x");
+	EXPECT_EQ(strings.size(), 4u);
+	EXPECT_THROW(strings.values<unsigned_ini_t>(), bad_cast_exception);
+	EXPECT_THROW(strings.at<unsigned_ini_t>(3), bad_cast_exception);
+	EXPECT_EQ(strings.at<unsigned_ini_t>(0), 4u);
+
+	// single short string is held by the view itself, copy of the view holds its own
+	option word("word", "short");
+	value_view<string_ini_t> single = word.values<string_ini_t>();
+	value_view<string_ini_t> single_copy = single;
+	single = value_view<string_ini_t>();
+	EXPECT_TRUE(single.empty());
+	EXPECT_EQ(single_copy.size(), 1u);
+	EXPECT_EQ(single_copy[0], "short");
+	EXPECT_EQ(single_copy.end() - single_copy.begin(), 1);
+	EXPECT_EQ(&single_copy[0], &*single_copy.begin());
+
+	option empty("empty", std::vector<std::string>{});
+	EXPECT_EQ(empty.size(), 0u);
+	EXPECT_TRUE(empty.values<signed_ini_t>().empty());
+	EXPECT_EQ(empty.values<signed_ini_t>().begin(), empty.values<signed_ini_t>().end());
+}
+
+TEST(option, typed_list_storage)
+{
+	option flags("flags");
+	flags.set_list<boolean_ini_t>({true, false, true});
+	value_view<boolean_ini_t> bits = flags.values<boolean_ini_t>();
+	EXPECT_EQ(std::vector<boolean_ini_t>(bits.begin(), bits.end()), (std::vector<boolean_ini_t>{true, false, true}));
+	EXPECT_FALSE(bits[1]);
+	flags.remove_from_list<boolean_ini_t>(false);
+	EXPECT_EQ(flags.get_list<boolean_ini_t>(), (std::vector<boolean_ini_t>{true, true}));
+	EXPECT_EQ(flags.at<string_ini_t>(0), "yes");
+	EXPECT_THROW(flags.get<signed_ini_t>(), bad_cast_exception);
+	EXPECT_THROW(flags.add_to_list<signed_ini_t>(1), bad_cast_exception);
+
+	option numbers("numbers");
+	numbers.set_list<float_ini_t>({1.5, 2.5});
+	numbers.add_to_list<float_ini_t>(0.5, 0);
+	EXPECT_EQ(numbers.get_list<float_ini_t>(), (std::vector<float_ini_t>{0.5, 1.5, 2.5}));
+	numbers.remove_from_list_pos(1);
+	EXPECT_EQ(numbers.get_list<string_ini_t>(), (std::vector<string_ini_t>{"0.5", "2.5"}));
+	std::ostringstream str;
+	str << numbers;
+	EXPECT_EQ(str.str(), "numbers = 0.5,2.5\n");
+
+	option enums("enums");
+	enums.set_list<enum_ini_t>({enum_ini_t("first"), enum_ini_t("second")});
+	enums.remove_from_list<enum_ini_t>(enum_ini_t("first"));
+	EXPECT_EQ(enums.size(), 1u);
+	EXPECT_EQ(static_cast<std::string>(enums.values<enum_ini_t>()[0]), "second");
+
+	// list of other type can be set after all values are removed
+	numbers.remove_from_list_pos(0);
+	numbers.remove_from_list_pos(0);
+	EXPECT_TRUE(numbers.holds_type<signed_ini_t>());
+	numbers.add_to_list<signed_ini_t>(3);
+	EXPECT_EQ(numbers.get<signed_ini_t>(), 3);
+
+	// values of different types are not equal, empty lists always are
+	option strings("numbers", std::vector<std::string>{"3"});
+	EXPECT_NE(numbers, strings);
+	numbers.remove_from_list_pos(0);
+	strings.remove_from_list_pos(0);
+	EXPECT_EQ(numbers, strings);
+}
+
+TEST(option, compact_value_storage)
+{
+	EXPECT_EQ(sizeof(value_list), 16u);
+
+	// single values are stored inline, lists and long strings spill to heap
+	option opt("opt", "short string");
+	EXPECT_EQ(opt.get<string_ini_t>(), "short string");
+	opt = "string longer than inline storage";
+	EXPECT_EQ(opt.values<string_ini_t>()[0], "string longer than inline storage");
+	opt.add_to_list<string_ini_t>("second");
+	EXPECT_EQ(opt.get_list<string_ini_t>(), (std::vector<string_ini_t>{"string longer than inline storage", "second"}));
+	opt.remove_from_list_pos(0);
+	EXPECT_EQ(opt.get<string_ini_t>(), "second");
+	EXPECT_FALSE(opt.is_list());
+
+	opt = static_cast<signed_ini_t>(-42);
+	EXPECT_EQ(opt.values<signed_ini_t>().size(), 1u);
+	EXPECT_EQ(opt.values<signed_ini_t>()[0], -42);
+	opt.add_to_list<signed_ini_t>(7, 0);
+	EXPECT_EQ(opt.get_list<signed_ini_t>(), (std::vector<signed_ini_t>{7, -42}));
+	opt.remove_from_list<signed_ini_t>(7);
+	opt.remove_from_list<signed_ini_t>(-42);
+	EXPECT_EQ(opt.size(), 0u);
+
+	opt = true;
+	EXPECT_TRUE(opt.values<boolean_ini_t>()[0]);
+	opt = enum_ini_t("short");
+	EXPECT_EQ(static_cast<std::string>(opt.get<enum_ini_t>()), "short");
+
+	// copies and moves keep inline and heap values
+	option list("list", std::vector<std::string>{"1", "2"});
+	option copy = list;
+	option moved = std::move(copy);
+	EXPECT_EQ(moved, list);
+	EXPECT_EQ(moved.get_list<unsigned_ini_t>(), (std::vector<unsigned_ini_t>{1, 2}));
+	option single("list", "1");
+	moved = single;
+	EXPECT_EQ(moved, single);
+	EXPECT_NE(moved, list);
+}
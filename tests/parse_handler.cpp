@@ -0,0 +1,148 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "parser.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace inicpp;
+
+namespace
+{
+	/**
+	 * Handler which records all events as text.
+	 */
+	class recording_handler : public parse_handler
+	{
+	public:
+		std::vector<std::string> events;
+		bool skip_errors = false;
+		size_t stop_after = std::string::npos;
+
+		bool record(const std::string &event)
+		{
+			events.push_back(std::to_string(line_number()) + " " + event);
+			return events.size() < stop_after;
+		}
+
+		bool on_section(std::string_view name) override
+		{
+			return record("section " + std::string(name));
+		}
+
+		bool on_option(std::string_view name, const std::vector<std::string_view> &values) override
+		{
+			std::string event = "option " + std::string(name) + " =";
+			for (auto value : values) { event += " [" + std::string(value) + "]"; }
+			return record(event);
+		}
+
+		bool on_comment(std::string_view comment) override
+		{
+			return record("comment" + std::string(comment));
+		}
+
+		bool on_error(const parser_exception &error) override
+		{
+			if (!skip_errors) { return parse_handler::on_error(error); }
+			return record(std::string("error ") + error.what());
+		}
+	};
+} // namespace
+
+TEST(parse_handler, events)
+{
+	std::string str_config = ""
+							 "; first comment\n"
+							 "[section]\n"
+							 "opt = val\n"
+							 "\n"
+							 "opt2 = val2, val\\,3 : val4 ; list\n"
+							 "[section2::a]\n"
+							 "link = ${section#opt}\n"
+							 "colons = a:b\\: c";
+	std::vector<std::string> expected{"1 comment first comment",
+		"2 section section",
+		"3 option opt = [val]",
+		"5 option opt2 = [val2] [val,3 : val4]",
+		"5 comment list",
+		"6 section section2::a",
+		"7 option link = [${section#opt}]",
+		"8 option colons = [a] [b: c]"};
+
+	recording_handler handler;
+	EXPECT_TRUE(parser::parse(str_config, handler));
+	EXPECT_EQ(handler.events, expected);
+
+	std::istringstream stream(str_config);
+	recording_handler stream_handler;
+	EXPECT_TRUE(parser::parse(stream, stream_handler));
+	EXPECT_EQ(stream_handler.events, expected);
+
+	// default handler accepts everything
+	parse_handler empty_handler;
+	EXPECT_TRUE(parser::parse(str_config, empty_handler));
+	EXPECT_EQ(empty_handler.line_number(), 8u);
+}
+
+TEST(parse_handler, stop)
+{
+	std::string str_config = ""
+							 "[section]\n"
+							 "opt = val\n"
+							 "opt2 = val2\n"
+							 "[section2]\n";
+
+	recording_handler handler;
+	handler.stop_after = 2;
+	EXPECT_FALSE(parser::parse(str_config, handler));
+	EXPECT_EQ(handler.events, (std::vector<std::string>{"1 section section", "2 option opt = [val]"}));
+}
+
+TEST(parse_handler, errors)
+{
+	std::string str_config = ""
+							 "opt = before section\n"
+							 "[section]\n"
+							 "[section\n"
+							 "opt =\n"
+							 "opt = val\n"
+							 "opt = val\n"
+							 "link = ${nonexisting#opt}";
+
+	// default on_error throws the same error as load
+	recording_handler throwing_handler;
+	EXPECT_THROW(parser::parse(str_config, throwing_handler), parser_exception);
+	EXPECT_TRUE(throwing_handler.events.empty());
+
+	// duplicates and links are not checked, config is not built
+	recording_handler handler;
+	handler.skip_errors = true;
+	EXPECT_TRUE(parser::parse(str_config, handler));
+	EXPECT_EQ(handler.events,
+		(std::vector<std::string>{"1 error Option not in section on line 1",
+			"2 section section",
+			"3 error Section not ended on line 3",
+			"4 error Option value cannot be empty on line 4",
+			"5 option opt = [val]",
+			"6 option opt = [val]",
+			"7 option link = [${nonexisting#opt}]"}));
+}
+
+TEST(parse_handler, parse_file)
+{
+	recording_handler handler;
+	EXPECT_THROW(parser::parse_file("nonexisting_file.txt", handler), parser_exception);
+
+	std::string file_name = "parse_handler_test.ini";
+	{
+		std::ofstream file(file_name);
+		file << "[section]\nopt = val ; comment\n";
+	}
+	EXPECT_TRUE(parser::parse_file(file_name, handler));
+	EXPECT_EQ(handler.events,
+		(std::vector<std::string>{"1 section section", "2 option opt = [val]", "2 comment comment"}));
+	std::remove(file_name.c_str());
+}
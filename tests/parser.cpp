@@ -3,6 +3,10 @@
 
 #include "parser.h"
 
+#include <memory_resource>
+#include <random>
+#include <thread>
+
 using namespace inicpp;
 
 /*
@@ -131,3 +135,472 @@ TEST(parser, store_config)
 								  "unsigned = 42\n";
 	EXPECT_EQ(str.str(), expected_result);
 }
+
+TEST(parser, load_file_mapped)
+{
+	EXPECT_THROW(parser::load_file_mapped("nonexisting_file.txt"), parser_exception);
+
+	std::string str_config = ""
+							 "[section]\n"
+							 "opt = val\n"
+							 "opt2 = val2, val3, val4\r\n"
+							 "; other comment\n"
+							 "\n"
+							 "[section2::a] ;with comment\n"
+							 "link = ${section#opt}\n"
+							 "escaped = \\ a\\,b\\ ";
+	std::string file_name = "inicpp_load_file_mapped.ini";
+	{
+		std::ofstream output(file_name, std::ios::binary);
+		output << str_config;
+	}
+
+	config mapped_config = parser::load_file_mapped(file_name);
+	EXPECT_EQ(mapped_config, parser::load_file(file_name));
+	EXPECT_EQ(mapped_config, parser::load(str_config));
+	EXPECT_EQ(mapped_config.size(), 2u);
+	EXPECT_EQ(mapped_config["section2::a"]["escaped"].get<string_ini_t>(), " a,b ");
+
+	// empty file cannot be mapped, but it still has to be loaded
+	{
+		std::ofstream output(file_name, std::ios::binary | std::ios::trunc);
+	}
+	EXPECT_EQ(parser::load_file_mapped(file_name).size(), 0u);
+
+	// errors are reported the same way as from stream variant
+	{
+		std::ofstream output(file_name, std::ios::binary | std::ios::trunc);
+		output << "[section]\nopt\n";
+	}
+	EXPECT_THROW(parser::load_file_mapped(file_name), parser_exception);
+
+	std::remove(file_name.c_str());
+}
+
+namespace
+{
+	std::string list_config(size_t count)
+	{
+		std::string result = "[section]\nlist = ";
+		for (size_t i = 0; i < count; ++i) {
+			if (i != 0) { result += ", "; }
+			result += "v" + std::to_string(i % 1000);
+		}
+		return result + "\n";
+	}
+
+	std::string escaped_config(size_t count)
+	{
+		std::string result = "[section]\nescaped = \\ ";
+		for (size_t i = 0; i < count; ++i) { result += "\\,\\\\"; }
+		return result + "\\ \n";
+	}
+} // namespace
+
+TEST(parser, long_option_list)
+{
+	config cfg = parser::load(list_config(10000));
+	auto list = cfg["section"]["list"].get_list<string_ini_t>();
+	ASSERT_EQ(list.size(), 10000u);
+	EXPECT_EQ(list.front(), "v0");
+	EXPECT_EQ(list[1234], "v234");
+	EXPECT_EQ(list.back(), "v999");
+}
+
+TEST(parser, long_escaped_value)
+{
+	config cfg = parser::load(escaped_config(5000));
+	auto value = cfg["section"]["escaped"].get<string_ini_t>();
+	ASSERT_EQ(value.length(), 5000u * 2 + 2);
+	EXPECT_EQ(value.substr(0, 6), " ,\\,\\,");
+	EXPECT_EQ(value.back(), ' ');
+	EXPECT_FALSE(cfg["section"]["escaped"].is_list());
+}
+
+namespace
+{
+	/*
+	 * Straightforward byte by byte implementation of value splitting,
+	 * which is used as a reference for vectorized scanner.
+	 */
+	size_t reference_find(const std::string &str, char ch)
+	{
+		bool escaped = false;
+		for (size_t i = 0; i < str.length(); ++i) {
+			if (escaped) {
+				escaped = false;
+			} else if (str[i] == '\\') {
+				escaped = true;
+			} else if (str[i] == ch) {
+				return i;
+			}
+		}
+		return std::string::npos;
+	}
+
+	std::vector<std::string> reference_option_list(const std::string &line)
+	{
+		std::string content = line.substr(0, reference_find(line, ';'));
+		std::string searched = content.substr(reference_find(content, '=') + 1);
+		char delim = reference_find(searched, ',') == std::string::npos ? ':' : ',';
+
+		std::vector<std::string> result;
+		while (true) {
+			size_t pos = reference_find(searched, delim);
+			std::string value = string_utils::left_trim(searched.substr(0, pos));
+			std::string trimmed = string_utils::right_trim(value);
+
+			// trailing whitespace stays if it is escaped
+			bool escaped = false;
+			for (size_t i = 0; i < value.length(); ++i) {
+				if (i == trimmed.length() && escaped && value[i] == ' ') { trimmed.push_back(' '); }
+				escaped = !escaped && value[i] == '\\';
+			}
+
+			std::string unescaped;
+			escaped = false;
+			for (char ch : trimmed) {
+				if (!escaped && ch == '\\') {
+					escaped = true;
+					continue;
+				}
+				escaped = false;
+				unescaped.push_back(ch);
+			}
+			result.push_back(unescaped);
+
+			if (pos == std::string::npos) { break; }
+			searched = searched.substr(pos + 1);
+		}
+		return result;
+	}
+} // namespace
+
+TEST(parser, scanner_matches_reference)
+{
+	// characters with special meaning are frequent, so escape sequences cross 64 byte blocks often
+	const std::string alphabet = "ab \t\\\\\\,:;#=";
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<size_t> char_dist(0, alphabet.length() - 1);
+	std::uniform_int_distribution<size_t> length_dist(1, 300);
+
+	for (size_t i = 0; i < 3000; ++i) {
+		std::string value;
+		size_t length = length_dist(generator);
+		for (size_t j = 0; j < length; ++j) { value.push_back(alphabet[char_dist(generator)]); }
+
+		std::string line = "opt = x" + value;
+		auto expected = reference_option_list(line);
+		auto cfg = parser::load("[section]\n" + line);
+		ASSERT_EQ(cfg["section"]["opt"].get_list<string_ini_t>(), expected) << "line: " << line;
+	}
+}
+
+namespace
+{
+	std::string sections_config(size_t count)
+	{
+		std::string result = "; generated config\n";
+		for (size_t i = 0; i < count; ++i) {
+			std::string name = "section" + std::to_string(i);
+			result += "[" + name + "] ; comment\n";
+			result += "opt = value " + std::to_string(i) + "\n";
+			result += "list = a, b\\, c, " + std::to_string(i) + "\n";
+			if (i > 0) {
+				// link to previous section, which can be in different chunk, and chained link
+				result += "prev = ${section" + std::to_string(i - 1) + "#opt}, x\n";
+			}
+			if (i > 1) { result += "chain = ${section" + std::to_string(i - 1) + "#prev}\n"; }
+			result += "self = ${" + name + "#opt}\n";
+			result += "\n";
+		}
+		return result;
+	}
+
+	template <typename Fn> std::string error_message(Fn fn)
+	{
+		try {
+			fn();
+		} catch (const std::exception &e) {
+			return e.what();
+		}
+		return "";
+	}
+} // namespace
+
+TEST(parser, load_parallel)
+{
+	std::string str_config = sections_config(3000);
+	config expected = parser::load(str_config);
+	ASSERT_EQ(expected.size(), 3000u);
+	EXPECT_EQ(expected["section7"]["chain"].get<string_ini_t>(), "value 5");
+
+	for (size_t threads : {0, 1, 2, 3, 8}) {
+		config parallel = parser::load_parallel(str_config, threads);
+		ASSERT_EQ(parallel.size(), expected.size());
+		EXPECT_EQ(parallel, expected);
+		EXPECT_EQ(parallel["section7"]["chain"].get<string_ini_t>(), "value 5");
+		EXPECT_EQ(parallel["section2500"]["prev"].get_list<string_ini_t>(),
+			(std::vector<std::string>{"value 2499", "x"}));
+	}
+
+	// errors have to be the same as from sequential parsing
+	std::string duplicate = str_config + "[section10]\nopt = 1\n" + sections_config(1);
+	EXPECT_THROW(parser::load_parallel(duplicate, 4), ambiguity_exception);
+	EXPECT_EQ(error_message([&]() { parser::load_parallel(duplicate, 4); }),
+		error_message([&]() { parser::load(duplicate); }));
+
+	std::string forward_link = "[first]\nopt = ${last#opt}\n" + str_config + "[last]\nopt = 1\n";
+	EXPECT_THROW(parser::load_parallel(forward_link, 4), parser_exception);
+	EXPECT_EQ(error_message([&]() { parser::load_parallel(forward_link, 4); }),
+		error_message([&]() { parser::load(forward_link); }));
+
+	std::string later_option = str_config + "[last]\nopt = ${last#other}\nother = 1\n";
+	EXPECT_EQ(error_message([&]() { parser::load_parallel(later_option, 4); }),
+		error_message([&]() { parser::load(later_option); }));
+
+	std::string bad_line = str_config + "[last\n";
+	EXPECT_EQ(error_message([&]() { parser::load_parallel(bad_line, 4); }),
+		error_message([&]() { parser::load(bad_line); }));
+}
+
+TEST(parser, load_lazy)
+{
+	std::string str_config = ""
+							 "[section]\n"
+							 "opt = val ; comment\n"
+							 "list = 1, 2 ,3\n"
+							 "colons = a : b\\: c\n"
+							 "escaped = \\ a\\,b\\ , c\\\\\n"
+							 "number = 42\n"
+							 "[linked]\n"
+							 "link = ${section#list}\n"
+							 "dollar = $value";
+	config expected = parser::load(str_config);
+	config lazy = parser::load_lazy(str_config);
+	EXPECT_EQ(lazy.size(), 2u);
+	EXPECT_EQ(lazy["section"]["number"].get<signed_ini_t>(), 42);
+	EXPECT_EQ(lazy["section"]["escaped"].get_list<string_ini_t>(), (std::vector<std::string>{" a,b ", "c\\"}));
+	EXPECT_EQ(lazy, expected);
+
+	std::istringstream stream(str_config);
+	EXPECT_EQ(parser::load_lazy(stream), expected);
+
+	// copies and threads which touch the same option see the same values
+	config copy = parser::load_lazy(str_config);
+	config copied(copy);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < 4; ++i) {
+		threads.emplace_back([&]() {
+			for (auto &sect : copy) {
+				for (auto &opt : sect) { EXPECT_EQ(opt, expected[sect.get_name()][opt.get_name()]); }
+			}
+		});
+	}
+	for (auto &thread : threads) { thread.join(); }
+	EXPECT_EQ(copied, expected);
+	std::ostringstream lazy_output, expected_output;
+	parser::save(parser::load_lazy(str_config), lazy_output);
+	parser::save(expected, expected_output);
+	EXPECT_EQ(lazy_output.str(), expected_output.str());
+
+	// saving is safe while other thread parses the same options
+	const config saved = parser::load_lazy(str_config);
+	std::thread reader([&saved]() {
+		for (auto &sect : saved) {
+			for (auto &opt : sect) { opt.size(); }
+		}
+	});
+	std::ostringstream saved_output;
+	parser::save(saved, saved_output);
+	reader.join();
+	EXPECT_EQ(saved_output.str(), expected_output.str());
+
+	// moved from option is empty, not unparsed
+	config moved_from = parser::load_lazy(str_config);
+	option source(moved_from["section"]["escaped"]);
+	option moved(std::move(source));
+	EXPECT_EQ(source.size(), 0u);
+	EXPECT_THROW(source.get<string_ini_t>(), not_found_exception);
+	EXPECT_EQ(moved.get_list<string_ini_t>(), (std::vector<std::string>{" a,b ", "c\\"}));
+	option assign_source(moved_from["section"]["escaped"]);
+	option assigned("other", "value");
+	assigned = std::move(assign_source);
+	EXPECT_EQ(assign_source.size(), 0u);
+	EXPECT_FALSE(assign_source.is_list());
+	EXPECT_EQ(assigned.size(), 2u);
+
+	// modification replaces unparsed value
+	config modified = parser::load_lazy(str_config);
+	modified["section"]["list"].set_list<signed_ini_t>({4, 5});
+	EXPECT_EQ(modified["section"]["list"].get_list<signed_ini_t>(), (std::vector<signed_ini_t>{4, 5}));
+	modified["section"]["opt"] = "new";
+	EXPECT_EQ(modified["section"]["opt"].get<string_ini_t>(), "new");
+	modified["section"]["colons"].remove_from_list_pos(0);
+	EXPECT_EQ(modified["section"]["colons"].get<string_ini_t>(), "b: c");
+
+	// all errors are reported during loading, the same as in eager mode
+	for (std::string bad : {"[section]\nopt = val\nopt = val2\n",
+			 "[section]\nopt = ${section#other}\n",
+			 "[section]\nopt = \\${other}\n",
+			 "[section]\nopt =\n",
+			 "opt = val\n"}) {
+		std::string message = error_message([&]() { parser::load(bad); });
+		EXPECT_FALSE(message.empty());
+		EXPECT_EQ(error_message([&]() { parser::load_lazy(bad); }), message);
+	}
+}
+
+TEST(parser, save_to_string)
+{
+	std::string str_config = sections_config(100);
+	config cfg = parser::load(str_config);
+	section &sect = cfg["section1"];
+	sect.add_option("float", float_ini_t(0.1 + 0.2));
+	sect.add_option("float_list", float_ini_t(0));
+	sect["float_list"].set_list<float_ini_t>({1e300, -2.5, 1e-7});
+	sect.add_option("signed", signed_ini_t(-9223372036854775807 - 1));
+	sect.add_option("unsigned", unsigned_ini_t(18446744073709551615u));
+	sect.add_option("bool", boolean_ini_t(true));
+	sect["bool"].add_to_list(boolean_ini_t(false));
+	sect.add_option("string", string_ini_t(" padded "));
+
+	std::string saved = parser::save_to_string(cfg);
+	std::ostringstream stream;
+	parser::save(cfg, stream);
+	EXPECT_EQ(saved, stream.str());
+
+	// every value is read back the same, floats are written in the shortest exact form
+	EXPECT_NE(saved.find("float = 0.30000000000000004\n"), std::string::npos);
+	EXPECT_NE(saved.find("float_list = 1e+300,-2.5,1e-07\n"), std::string::npos);
+	config reloaded = parser::load(saved);
+	EXPECT_EQ(reloaded["section1"]["float"].get<float_ini_t>(), 0.1 + 0.2);
+	EXPECT_EQ(reloaded["section1"]["signed"].get<signed_ini_t>(), -9223372036854775807 - 1);
+	EXPECT_EQ(reloaded["section1"]["unsigned"].get<unsigned_ini_t>(), 18446744073709551615u);
+	EXPECT_EQ(reloaded["section1"]["bool"].get_list<boolean_ini_t>(), (std::vector<boolean_ini_t>{true, false}));
+	EXPECT_EQ(reloaded["section1"]["string"].get<string_ini_t>(), " padded ");
+
+	// lazily loaded config is written the same
+	EXPECT_EQ(parser::save_to_string(parser::load_lazy(str_config)), parser::save_to_string(parser::load(str_config)));
+	EXPECT_EQ(parser::save_to_string(config()), "");
+}
+
+TEST(parser, try_load)
+{
+	std::string str_config = ""
+							 "[section]\n"
+							 "opt = val ; comment\n"
+							 "list = 1, 2 ,3\n"
+							 "[linked]\n"
+							 "link = ${section#list}\n";
+	load_result result = parser::try_load(str_config);
+	ASSERT_TRUE(result);
+	EXPECT_TRUE(result.has_value());
+	EXPECT_EQ(*result, parser::load(str_config));
+	EXPECT_EQ(result->size(), 2u);
+	std::istringstream stream(str_config);
+	EXPECT_EQ(parser::try_load(stream).value(), parser::load(str_config));
+
+	// every error is reported with the same message as by load(), but without throwing
+	for (std::string bad : {"[section]\nopt = val\nopt = val2\n",
+			 "[section]\n[other]\n[section]\n",
+			 "[section]\nopt = ${section#other}\n",
+			 "[section]\nopt = ${other#opt}\n",
+			 "[section]\nopt = ${#opt}\n",
+			 "[section]\nopt = ${section}\n",
+			 "[section]\nopt =\n",
+			 "[section\n",
+			 "[]\n",
+			 "[1section]\n",
+			 "[section]\nopt\n",
+			 "opt = val\n"}) {
+		std::string message = error_message([&]() { parser::load(bad); });
+		EXPECT_FALSE(message.empty());
+		load_result failed = parser::try_load(bad);
+		ASSERT_FALSE(failed);
+		EXPECT_EQ(failed.error().message(), message);
+		EXPECT_EQ(error_message([&]() { failed.value(); }), message);
+		std::istringstream bad_stream(bad);
+		EXPECT_EQ(parser::try_load(bad_stream).error().message(), message);
+	}
+
+	// position of the error
+	load_result failed = parser::try_load("; comment\n[section]\n  opt =\n");
+	ASSERT_FALSE(failed);
+	EXPECT_EQ(failed.error().code(), load_error_code::empty_option_value);
+	EXPECT_EQ(failed.error().line(), 3u);
+	EXPECT_EQ(failed.error().column(), 7u);
+	EXPECT_EQ(failed.error().offset(), 26u);
+	failed = parser::try_load("[section]\n\n  [1a]\n");
+	EXPECT_EQ(failed.error().code(), load_error_code::invalid_identifier);
+	EXPECT_EQ(failed.error().line(), 3u);
+	EXPECT_EQ(failed.error().column(), 3u);
+	EXPECT_EQ(failed.error().offset(), 13u);
+	failed = parser::try_load("[section]\nopt = 1\nopt = 2\n");
+	EXPECT_EQ(failed.error().code(), load_error_code::duplicate_option);
+	EXPECT_EQ(failed.error().line(), 3u);
+	EXPECT_EQ(failed.error().column(), 0u);
+	EXPECT_EQ(failed.error().offset(), 18u);
+	failed = parser::try_load("[section]\n[section]\nopt = 1\n");
+	EXPECT_EQ(failed.error().code(), load_error_code::duplicate_section);
+	EXPECT_EQ(failed.error().line(), 2u);
+	EXPECT_EQ(failed.error().offset(), 10u);
+}
+
+TEST(parser, try_load_file_and_schema)
+{
+	load_result missing = parser::try_load_file("this_file_does_not_exist.ini");
+	ASSERT_FALSE(missing);
+	EXPECT_EQ(missing.error().code(), load_error_code::file_not_readable);
+	EXPECT_EQ(missing.error().message(), error_message([]() { parser::load_file("this_file_does_not_exist.ini"); }));
+
+	std::string file_name = "try_load_test.ini";
+	{
+		std::ofstream file(file_name);
+		file << "[section]\nnumber = abc\n";
+	}
+	load_result loaded = parser::try_load_file(file_name);
+	ASSERT_TRUE(loaded);
+	EXPECT_EQ(loaded->operator[]("section")["number"].get<string_ini_t>(), "abc");
+
+	// validation errors are reported in the result too
+	schema schm;
+	section_schema_params sect_params;
+	sect_params.name = "section";
+	schm.add_section(sect_params);
+	option_schema_params<signed_ini_t> opt_params;
+	opt_params.name = "number";
+	schm.add_option("section", opt_params);
+
+	std::string message = error_message([&]() { parser::load_file(file_name, schm, schema_mode::strict); });
+	EXPECT_FALSE(message.empty());
+	load_result invalid = parser::try_load_file(file_name, schm, schema_mode::strict);
+	ASSERT_FALSE(invalid);
+	EXPECT_EQ(invalid.error().code(), load_error_code::validation_failed);
+	EXPECT_EQ(invalid.error().message(), message);
+	EXPECT_FALSE(parser::try_load("[section]\nnumber = abc\n", schm, schema_mode::strict));
+	std::istringstream stream("[section]\nnumber = 42\n");
+	load_result valid = parser::try_load(stream, schm, schema_mode::strict);
+	ASSERT_TRUE(valid);
+	EXPECT_EQ(valid->operator[]("section")["number"].get<signed_ini_t>(), 42);
+	std::remove(file_name.c_str());
+}
+
+TEST(parser, load_into_memory_resource)
+{
+	std::string str = "[section]\nopt = 1, 2, 3\nname = value\n[other]\nlink = ${section#name}\n";
+	std::pmr::monotonic_buffer_resource arena;
+	{
+		config cfg = parser::load(str, &arena);
+		EXPECT_EQ(cfg.get_memory_resource(), &arena);
+		EXPECT_EQ(cfg["section"].get_memory_resource(), &arena);
+		EXPECT_EQ(cfg, parser::load(str));
+		EXPECT_EQ(cfg["other"]["link"].get<string_ini_t>(), "value");
+
+		std::istringstream stream(str);
+		config from_stream = parser::load(stream, &arena);
+		EXPECT_EQ(from_stream, cfg);
+		EXPECT_THROW(parser::load_file("this-file-does-not-exist.ini", &arena), parser_exception);
+	}
+	arena.release();
+}
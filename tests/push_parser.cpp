@@ -0,0 +1,107 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "parser.h"
+#include "push_parser.h"
+
+#include <sstream>
+
+using namespace inicpp;
+
+namespace
+{
+	const std::string str_config = ""
+								   "; comment\n"
+								   "[section]\n"
+								   "opt = val\n"
+								   "\n"
+								   "escaped = a\\,b, c\\\\, d\\ \n"
+								   "[section2::a] ;with comment\n"
+								   "link = ${section#opt}\n"
+								   "list = 1 : 2 : 3";
+
+	std::string saved(const config &cfg)
+	{
+		std::ostringstream str;
+		parser::save(cfg, str);
+		return str.str();
+	}
+} // namespace
+
+TEST(push_parser, chunk_boundaries)
+{
+	std::string expected = saved(parser::load(str_config));
+
+	push_parser parser;
+	EXPECT_TRUE(parser.feed(str_config));
+	EXPECT_EQ(saved(parser.finish()), expected);
+
+	// every split point, including ones inside escape sequences
+	for (size_t split = 0; split <= str_config.length(); ++split) {
+		EXPECT_TRUE(parser.feed(str_config.data(), split));
+		EXPECT_TRUE(parser.feed(str_config.data() + split, str_config.length() - split));
+		EXPECT_EQ(saved(parser.finish()), expected) << "split at " << split;
+	}
+
+	// one byte at a time
+	for (char ch : str_config) { EXPECT_TRUE(parser.feed(&ch, 1)); }
+	EXPECT_EQ(saved(parser.finish()), expected);
+
+	// trailing newline does not matter
+	EXPECT_TRUE(parser.feed(str_config + "\n"));
+	EXPECT_EQ(saved(parser.finish()), expected);
+
+	EXPECT_EQ(parser.finish().size(), 0u);
+}
+
+TEST(push_parser, errors)
+{
+	push_parser parser;
+	parser.feed("[section]\nopt = ");
+	try {
+		parser.feed("val\nopt = val2\n[sec");
+		FAIL() << "Expected ambiguity_exception";
+	} catch (ambiguity_exception &) {
+	}
+
+	// parse error on the last line is reported by finish
+	push_parser other_parser;
+	EXPECT_TRUE(other_parser.feed("[section]\nopt = val\n[section"));
+	try {
+		other_parser.finish();
+		FAIL() << "Expected parser_exception";
+	} catch (parser_exception &e) {
+		EXPECT_EQ(std::string(e.what()), "Section not ended on line 3");
+	}
+}
+
+TEST(push_parser, handler)
+{
+	class counting_handler : public parse_handler
+	{
+	public:
+		size_t sections = 0;
+		size_t options = 0;
+
+		bool on_section(std::string_view) override
+		{
+			++sections;
+			return true;
+		}
+
+		bool on_option(std::string_view, const std::vector<std::string_view> &) override
+		{
+			++options;
+			return options < 3;
+		}
+	};
+
+	counting_handler handler;
+	push_parser parser(handler);
+	EXPECT_TRUE(parser.feed(str_config.substr(0, 40)));
+	EXPECT_FALSE(parser.feed(str_config.substr(40)));
+	EXPECT_FALSE(parser.feed("[section3]\n"));
+	EXPECT_EQ(parser.finish().size(), 0u);
+	EXPECT_EQ(handler.sections, 2u);
+	EXPECT_EQ(handler.options, 3u);
+}
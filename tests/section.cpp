@@ -41,6 +41,30 @@ TEST(section, adding_and_removing_options)
 	EXPECT_EQ(sect[0].get_name(), "opt2");
 }
 
+TEST(section, string_view_lookup)
+{
+	section sect("name");
+	sect.add_option("opt", "value");
+	sect.add_option("opt2", "value2");
+
+	// views into a larger buffer, which are not null terminated
+	std::string buffer = "opt2opt3";
+	std::string_view name = std::string_view(buffer).substr(0, 3);
+	EXPECT_TRUE(sect.contains(name));
+	EXPECT_EQ(sect[name].get_name(), "opt");
+	EXPECT_EQ(sect[std::string_view(buffer).substr(0, 4)].get<string_ini_t>(), "value2");
+	EXPECT_FALSE(sect.contains(std::string_view(buffer).substr(4)));
+	EXPECT_THROW(sect[std::string_view(buffer).substr(4)], not_found_exception);
+
+	const section &const_sect = sect;
+	EXPECT_EQ(const_sect["opt"].get_name(), "opt");
+	EXPECT_TRUE(const_sect.contains(std::string("opt2")));
+
+	sect.remove_option(name);
+	EXPECT_FALSE(sect.contains("opt"));
+	EXPECT_EQ(sect[0].get_name(), "opt2");
+}
+
 TEST(section, iterators)
 {
 	section sect("name");
@@ -74,3 +98,43 @@ TEST(section, stream_output)
 	str << sect;
 	EXPECT_EQ(str.str(), "[section name]\nopt_name = opt_value\nkey = value\n");
 }
+
+TEST(section, find_try_get_and_get_or)
+{
+	section sect("name");
+	sect.add_option("number", "42");
+	sect.add_option("flag", boolean_ini_t(true));
+
+	ASSERT_NE(sect.find("number"), nullptr);
+	EXPECT_EQ(sect.find("number")->get_name(), "number");
+	EXPECT_EQ(sect.find("missing"), nullptr);
+	const section &const_sect = sect;
+	EXPECT_EQ(const_sect.find("flag"), &sect["flag"]);
+	EXPECT_EQ(const_sect.find("missing"), nullptr);
+
+	EXPECT_EQ(sect.try_get<signed_ini_t>("number"), std::optional<signed_ini_t>(42));
+	EXPECT_EQ(sect.try_get<signed_ini_t>("missing"), std::nullopt);
+	EXPECT_EQ(sect.try_get<signed_ini_t>("flag"), std::nullopt);
+	EXPECT_EQ(sect.get_or<unsigned_ini_t>("number", 7), 42u);
+	EXPECT_EQ(sect.get_or<unsigned_ini_t>("missing", 7), 7u);
+	EXPECT_EQ(sect.get_or<boolean_ini_t>("flag", false), true);
+	EXPECT_EQ(sect.get_or<boolean_ini_t>("number", false), false);
+}
+
+TEST(section, emplace_and_move_options)
+{
+	section sect("name");
+	option &emplaced = sect.emplace_option("list", std::vector<std::string>{"a", "b"});
+	EXPECT_EQ(&emplaced, &sect["list"]);
+	EXPECT_EQ(emplaced.get_list<string_ini_t>(), (std::vector<string_ini_t>{"a", "b"}));
+	EXPECT_EQ(sect.emplace_option("single", "value").get<string_ini_t>(), "value");
+	EXPECT_THROW(sect.emplace_option("list", "other"), ambiguity_exception);
+	EXPECT_EQ(sect["list"].get_list<string_ini_t>().size(), 2u);
+
+	option opt("moved", "12");
+	sect.add_option(std::move(opt));
+	EXPECT_EQ(sect.size(), 3u);
+	EXPECT_EQ(sect["moved"].get<signed_ini_t>(), 12);
+	EXPECT_THROW(sect.add_option(option("moved", "13")), ambiguity_exception);
+	EXPECT_EQ(sect["moved"].get<signed_ini_t>(), 12);
+}
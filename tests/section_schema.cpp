@@ -88,6 +88,13 @@ TEST(section_schema, adding_and_removing_options)
 	EXPECT_THROW(my_section.remove_option("unknown name"), not_found_exception);
 	EXPECT_NO_THROW(my_section.remove_option(my_option.get_name()));
 	EXPECT_NO_THROW(my_section.remove_option(opt_params.name));
+
+	// stored option schema keeps the name it is found by
+	my_section.add_option(my_option);
+	opt_params.name = "renamed";
+	my_section["name"] = option_schema(opt_params);
+	EXPECT_EQ(my_section["name"].get_name(), "name");
+	EXPECT_FALSE(my_section.contains("renamed"));
 }
 
 TEST(section_schema, validation)
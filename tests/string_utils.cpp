@@ -4,6 +4,11 @@
 #include "exception.h"
 #include "string_utils.h"
 
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <regex>
+
 using namespace inicpp;
 using namespace string_utils;
 using namespace std;
@@ -46,6 +51,33 @@ TEST(string_utils, trim)
 	ASSERT_EQ("Hello World!", trim(str));
 }
 
+TEST(string_utils, trim_string_view)
+{
+	string str = " \f \n Hello World! \t \v";
+	string_view view = str;
+
+	// views point into the original string, nothing is copied
+	string_view trimmed = trim(view);
+	ASSERT_EQ("Hello World!", trimmed);
+	ASSERT_EQ(str.data() + 5, trimmed.data());
+	ASSERT_EQ("Hello World! \t \v", left_trim(view));
+	ASSERT_EQ(" \f \n Hello World!", right_trim(view));
+
+	ASSERT_EQ("", trim(string_view()));
+	ASSERT_EQ("", left_trim(string_view("   ")));
+	ASSERT_EQ("", right_trim(string_view("   ")));
+
+	// string literals still result in owned string
+	string literal_result = trim(" A ");
+	ASSERT_EQ("A", literal_result);
+	ASSERT_EQ("A ", left_trim(" A "));
+	ASSERT_EQ(" A", right_trim(" A "));
+
+	// bytes with highest bit set are not whitespaces
+	str = " \xC3\xA1 ";
+	ASSERT_EQ("\xC3\xA1", trim(string_view(str)));
+}
+
 TEST(string_utils, starts_with)
 {
 	string str = "";
@@ -77,6 +109,9 @@ TEST(string_utils, starts_with)
 
 	str = "Hello World!";
 	ASSERT_FALSE(starts_with(str, "World!"));
+
+	ASSERT_TRUE(starts_with(string_view(str).substr(6), "World"));
+	ASSERT_TRUE(starts_with("Hello World!", "Hello"));
 }
 
 TEST(string_utils, ends_with)
@@ -110,6 +145,9 @@ TEST(string_utils, ends_with)
 
 	str = "Hello World!";
 	ASSERT_FALSE(ends_with(str, "Hello"));
+
+	ASSERT_TRUE(ends_with(string_view(str).substr(0, 5), "llo"));
+	ASSERT_TRUE(ends_with("Hello World!", "!"));
 }
 
 TEST(string_utils, find_needle)
@@ -142,6 +180,40 @@ TEST(string_utils, find_needle)
 	ASSERT_TRUE(find_needle(str, "o W"));
 }
 
+TEST(string_utils, is_valid_identifier)
+{
+	ASSERT_FALSE(is_valid_identifier(""));
+	ASSERT_TRUE(is_valid_identifier("section"));
+	ASSERT_TRUE(is_valid_identifier("$Section::subsection"));
+	ASSERT_TRUE(is_valid_identifier("Option 1"));
+	ASSERT_TRUE(is_valid_identifier(".a-b_c~d"));
+	ASSERT_FALSE(is_valid_identifier("1option"));
+	ASSERT_FALSE(is_valid_identifier(" option"));
+	ASSERT_FALSE(is_valid_identifier("opt#ion"));
+	ASSERT_FALSE(is_valid_identifier("opt\xC3\xA1"));
+	ASSERT_FALSE(is_valid_identifier(string_view("opt\0", 4)));
+
+	// results have to be the same as from the original regular expression
+	std::regex reg_expr("^[a-zA-Z.$:][-a-zA-Z0-9_~.:$ ]*$");
+	for (int first = 0; first < 256; ++first) {
+		for (int second = 0; second < 256; ++second) {
+			string str = {static_cast<char>(first), static_cast<char>(second)};
+			ASSERT_EQ(std::regex_match(str, reg_expr), is_valid_identifier(str)) << first << " " << second;
+		}
+		string str(1, static_cast<char>(first));
+		ASSERT_EQ(std::regex_match(str, reg_expr), is_valid_identifier(str)) << first;
+	}
+
+	const string alphabet = "aZ09.$:-_~ #\n";
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<size_t> char_dist(0, alphabet.length() - 1);
+	for (size_t i = 0; i < 2000; ++i) {
+		string str;
+		for (size_t j = 0; j < 1 + i % 20; ++j) { str.push_back(alphabet[char_dist(generator)]); }
+		ASSERT_EQ(std::regex_match(str, reg_expr), is_valid_identifier(str)) << str;
+	}
+}
+
 TEST(string_utils, split)
 {
 	string str = "";
@@ -231,3 +303,242 @@ TEST(string_utils, parse_boolean_value)
 
 	EXPECT_THROW(string_utils::parse_string<boolean_ini_t>("random", ""), invalid_type_exception);
 }
+
+namespace
+{
+	/*
+	 * Reference implementation of number and boolean parsing based on standard conversion functions,
+	 * new implementation has to accept exactly the same strings with the same results.
+	 */
+	template <typename T> std::string reference_parse(const std::string &value, T &result);
+
+	template <> std::string reference_parse(const std::string &value, signed_ini_t &result)
+	{
+		try {
+			if (value.size() > 2 && value[0] == '0' && value[1] == 'b') {
+				result = std::stoll(value.substr(2), 0, 2);
+			} else {
+				result = std::stoll(value, 0, 0);
+			}
+		} catch (std::exception &e) {
+			return e.what();
+		}
+		return "";
+	}
+
+	template <> std::string reference_parse(const std::string &value, unsigned_ini_t &result)
+	{
+		try {
+			if (value.size() > 2 && value[0] == '0' && value[1] == 'b') {
+				result = std::stoull(value.substr(2), 0, 2);
+			} else {
+				result = std::stoull(value, 0, 0);
+			}
+		} catch (std::exception &e) {
+			return e.what();
+		}
+		return "";
+	}
+
+	template <> std::string reference_parse(const std::string &value, float_ini_t &result)
+	{
+		try {
+			result = std::stod(value);
+		} catch (std::exception &e) {
+			return e.what();
+		}
+		return "";
+	}
+
+	template <> std::string reference_parse(const std::string &value, boolean_ini_t &result)
+	{
+		if (value == "0" || value == "f" || value == "n" || value == "off" || value == "no" || value == "disabled") {
+			result = false;
+		} else if (value == "1" || value == "t" || value == "y" || value == "on" || value == "yes" ||
+			value == "enabled") {
+			result = true;
+		} else {
+			return "String '" + value + "' is not valid boolean type.";
+		}
+		return "";
+	}
+
+	template <typename T> void expect_same_parsing(const std::string &value)
+	{
+		T expected{};
+		std::string expected_error = reference_parse(value, expected);
+
+		T result{};
+		std::string error;
+		try {
+			result = string_utils::parse_string<T>(value, "opt");
+		} catch (invalid_type_exception &e) {
+			error = e.what();
+		}
+
+		T try_result{};
+		bool parsed = string_utils::try_parse_string<T>(value, try_result);
+		if (expected_error.empty()) {
+			EXPECT_TRUE(error.empty()) << "'" << value << "' " << error;
+			EXPECT_TRUE(parsed) << "'" << value << "'";
+			// results have to be identical including sign of zero and payload of NaN
+			EXPECT_EQ(std::memcmp(&result, &expected, sizeof(T)), 0) << "'" << value << "' " << result;
+			EXPECT_EQ(std::memcmp(&try_result, &expected, sizeof(T)), 0) << "'" << value << "'";
+		} else {
+			EXPECT_EQ(error, "Option 'opt' parsing failed: " + expected_error) << "'" << value << "'";
+			EXPECT_FALSE(parsed) << "'" << value << "'";
+		}
+	}
+
+	template <typename T> void expect_same_parsing(const std::vector<std::string> &values, const std::string &alphabet)
+	{
+		for (const auto &value : values) { expect_same_parsing<T>(value); }
+
+		std::mt19937 generator(7);
+		std::uniform_int_distribution<size_t> length_distribution(0, 10);
+		std::uniform_int_distribution<size_t> char_distribution(0, alphabet.size() - 1);
+		for (size_t i = 0; i < 100000; ++i) {
+			std::string value(length_distribution(generator), ' ');
+			for (auto &ch : value) { ch = alphabet[char_distribution(generator)]; }
+			expect_same_parsing<T>(value);
+		}
+	}
+} // namespace
+
+TEST(string_utils, parse_integer_matches_reference)
+{
+	std::vector<std::string> values{"",
+		"0",
+		"-0",
+		"+0",
+		"0x",
+		"0xg",
+		"0b",
+		"0b2",
+		"0b-101",
+		"0b 11",
+		" 0b11",
+		"0b0b1",
+		"017",
+		"019",
+		"  \t\n\v\f\r42",
+		"42abc",
+		"9223372036854775807",
+		"9223372036854775808",
+		"-9223372036854775808",
+		"-9223372036854775809",
+		"18446744073709551615",
+		"18446744073709551616",
+		"-18446744073709551615",
+		"-18446744073709551616",
+		"0xffffffffffffffff",
+		"0x10000000000000000",
+		"0b1111111111111111111111111111111111111111111111111111111111111111",
+		"0b10000000000000000000000000000000000000000000000000000000000000000",
+		"- 5",
+		"+-5",
+		"0X1aF",
+		"\xa0"
+		"5"};
+	std::string alphabet = "0123456789abfxXB+- \t";
+	expect_same_parsing<signed_ini_t>(values, alphabet);
+	expect_same_parsing<unsigned_ini_t>(values, alphabet);
+}
+
+TEST(string_utils, parse_float_matches_reference)
+{
+	std::vector<std::string> values{"",
+		"0",
+		"-0",
+		"-0.0",
+		".5",
+		"5.",
+		".",
+		"-.e1",
+		"1e",
+		"1e+",
+		"1e-5x",
+		"  \t1.5",
+		"1.7976931348623157e308",
+		"1.7976931348623159e308",
+		"1e309",
+		"-1e309",
+		"2.2250738585072014e-308",
+		"2.2250738585072011e-308",
+		"4.9e-324",
+		"1e-400",
+		"-1e-400",
+		"0e-400",
+		"0x",
+		"0x.",
+		"0x1p3",
+		"0x.8",
+		"-0x1.8p-1",
+		"0x1p",
+		"0x1p-1080",
+		"0x1p-1074",
+		"0x1p-1022",
+		"0x1fffffffffffffp971",
+		"inf",
+		"-INF",
+		"Infinity",
+		"infinit",
+		"nan",
+		"-NaN",
+		"nan(123)",
+		"nan()",
+		"nan(",
+		"0.1000000000000000055511151231257827021181583404541015625",
+		"123456789012345678901234567890",
+		"3.14"};
+	std::string alphabet = "0123456789.eExXp+- infa(";
+	expect_same_parsing<float_ini_t>(values, alphabet);
+}
+
+TEST(string_utils, parse_boolean_matches_reference)
+{
+	std::vector<std::string> values{"", "0", "1", "no", "on", "of", "off", "yes", "Yes", "enabled", "disabled", "yes "};
+	expect_same_parsing<boolean_ini_t>(values, "01ftnyoesabld");
+}
+
+TEST(string_utils, append_value)
+{
+	auto appended = [](const option_value &value) {
+		std::string result = "x=";
+		string_utils::append_value(result, value);
+		return result;
+	};
+
+	EXPECT_EQ(appended(boolean_ini_t(true)), "x=yes");
+	EXPECT_EQ(appended(boolean_ini_t(false)), "x=no");
+	EXPECT_EQ(appended(signed_ini_t(-9223372036854775807 - 1)), "x=-9223372036854775808");
+	EXPECT_EQ(appended(unsigned_ini_t(18446744073709551615u)), "x=18446744073709551615");
+	EXPECT_EQ(appended(float_ini_t(0.1)), "x=0.1");
+	EXPECT_EQ(appended(float_ini_t(-2.5e-300)), "x=-2.5e-300");
+	EXPECT_EQ(appended(string_ini_t("value")), "x=value");
+	EXPECT_EQ(appended(string_ini_t(" a b\t")), "x=\\ a b\\\t");
+	EXPECT_EQ(appended(enum_ini_t("enum")), "x=enum");
+
+	// shortest representation is parsed back to exactly the same value
+	std::mt19937_64 generator(42);
+	for (size_t i = 0; i < 1000; ++i) {
+		uint64_t bits = generator();
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		if (!std::isnormal(value)) { continue; }
+		std::string str;
+		string_utils::append_value(str, float_ini_t(value));
+		EXPECT_EQ(string_utils::parse_string<float_ini_t>(str, "x"), value) << str;
+	}
+}
+
+TEST(string_utils, append_escaped)
+{
+	std::string result;
+	string_utils::append_escaped(result, "");
+	EXPECT_EQ(result, "");
+	string_utils::append_escaped(result, "a b");
+	EXPECT_EQ(result, "a b");
+	string_utils::append_escaped(result, "  ");
+	EXPECT_EQ(result, "a b\\ \\ ");
+}
@@ -0,0 +1,93 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "parser.h"
+#include "symbol_table.h"
+
+#include <thread>
+
+using namespace inicpp;
+
+
+TEST(symbol_table, interning)
+{
+	symbol_table symbols;
+	EXPECT_EQ(symbols.size(), 0u);
+
+	std::string long_text(40, 'x');
+	const std::string &first = symbols.intern(long_text);
+	const std::string &second = symbols.intern(std::string(long_text));
+	EXPECT_EQ(&first, &second);
+	EXPECT_EQ(first, long_text);
+	EXPECT_EQ(symbols.size(), 1u);
+	EXPECT_EQ(symbols.bytes_saved(), long_text.size() + 1);
+
+	// short strings are stored inside of std::string, their copies cost nothing
+	const std::string &name = symbols.intern("a");
+	EXPECT_EQ(&name, &symbols.intern("a"));
+	EXPECT_NE(&name, &first);
+	EXPECT_EQ(symbols.size(), 2u);
+	EXPECT_EQ(symbols.bytes_saved(), long_text.size() + 1);
+}
+
+TEST(symbol_table, concurrent_interning)
+{
+	symbol_table symbols;
+	std::vector<std::thread> threads;
+	std::vector<const std::string *> results(4 * 100);
+	for (size_t t = 0; t < 4; ++t) {
+		threads.emplace_back([&symbols, &results, t]() {
+			for (size_t i = 0; i < 100; ++i) {
+				results[t * 100 + i] = &symbols.intern("symbol number " + std::to_string(i) + " with long name");
+			}
+		});
+	}
+	for (auto &thread : threads) { thread.join(); }
+
+	EXPECT_EQ(symbols.size(), 100u);
+	for (size_t t = 1; t < 4; ++t) {
+		for (size_t i = 0; i < 100; ++i) { EXPECT_EQ(results[t * 100 + i], results[i]); }
+	}
+}
+
+TEST(symbol_table, shared_config_storage)
+{
+	std::string str = "[section with quite long name]\n"
+					  "option with quite long name = value which does not fit inline\n"
+					  "list = 1, 2, 3\n"
+					  "short = text\n"
+					  "[other]\n"
+					  "link = ${section with quite long name#option with quite long name}\n";
+	symbol_table symbols;
+	config first = parser::load(str, symbols);
+	config second = parser::load(str, symbols);
+	EXPECT_EQ(first, parser::load(str));
+	EXPECT_EQ(first, second);
+	EXPECT_GT(symbols.bytes_saved(), 0u);
+
+	// equal names and values are stored once
+	const section &first_section = first["section with quite long name"];
+	const section &second_section = second["section with quite long name"];
+	EXPECT_EQ(&first_section.get_name(), &second_section.get_name());
+	const option &first_option = first_section["option with quite long name"];
+	const option &second_option = second_section["option with quite long name"];
+	EXPECT_EQ(&first_option.get_name(), &second_option.get_name());
+	EXPECT_EQ(first_option.get<string_ini_t>(), "value which does not fit inline");
+	EXPECT_EQ(first["other"]["link"].values<string_ini_t>()[0], "value which does not fit inline");
+	EXPECT_EQ(&first_option.values<string_ini_t>()[0], &second_option.values<string_ini_t>()[0]);
+
+	// interned option can be modified and copied as usual
+	config copy = second;
+	copy["section with quite long name"]["option with quite long name"].add_to_list<string_ini_t>("next");
+	EXPECT_EQ(copy["section with quite long name"]["option with quite long name"].size(), 2u);
+	EXPECT_EQ(second_option.size(), 1u);
+	EXPECT_NE(copy, second);
+
+	// config created without table can be interned later
+	config later = parser::load(str);
+	size_t saved = symbols.bytes_saved();
+	later.intern(symbols);
+	EXPECT_GT(symbols.bytes_saved(), saved);
+	EXPECT_EQ(later, first);
+	EXPECT_EQ(&later["other"].get_name(), &first["other"].get_name());
+}